@@ -0,0 +1,17 @@
+#ifndef APP_ALWAYS_ON_H
+#define APP_ALWAYS_ON_H
+
+#include <lvgl.h>
+
+// Seconds of inactivity on the home face before the always-on mode kicks in (0 = never)
+#ifndef WATCH_AOD_TIMEOUT
+#define WATCH_AOD_TIMEOUT 30
+#endif
+
+void AppAlwaysOn_Init();
+void AppAlwaysOn_Enter();                // Simplified face, panel in partial + idle mode
+void AppAlwaysOn_Exit(lv_obj_t *screen); // Full colour again, redraw `screen` immediately
+void AppAlwaysOn_Update();               // Redraws only when the minute changes
+bool AppAlwaysOn_IsActive();
+
+#endif
@@ -3,6 +3,8 @@
 
 #include <lvgl.h>
 
+#define APP_BREAKOUT_REFRESH_MS 16 // Display refresh period while shown (~60 Hz, ball motion)
+
 void AppBreakout_Init();
 void AppBreakout_Enter();
 void AppBreakout_Start();
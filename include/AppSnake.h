@@ -3,6 +3,8 @@
 
 #include <lvgl.h>
 
+#define APP_SNAKE_REFRESH_MS 33 // Display refresh period while shown (~30 Hz)
+
 // Direction constants
 #define DIR_UP 0
 #define DIR_RIGHT 1
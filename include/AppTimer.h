@@ -3,11 +3,15 @@
 
 #include <lvgl.h>
 
+#define APP_TIMER_REFRESH_MS 250 // Display refresh period while shown (countdown ticks once a second)
+
 void AppTimer_Init();
 void AppTimer_Adjust(int minutes);
 void AppTimer_Toggle();
 void AppTimer_Reset(); // ← Add this
 void AppTimer_Update();
+bool AppTimer_IsRunning();
+long AppTimer_MsToNextTick(); // Until the shown countdown changes, -1 when stopped
 void AppTimer_SetAlarmCallback(void (*callback)());
 lv_obj_t *AppTimer_GetScreen();
 
@@ -3,8 +3,20 @@
 
 #include <lvgl.h>
 
+#define APP_WEATHER_REFRESH_MS 1000 // Display refresh period while shown (data changes every 30 min)
+
+struct WeatherReading
+{
+    float temp_c;
+    float wind_kmh;
+    int code; // WMO weather code
+    int rain_prob;
+};
+
 void AppWeather_Init();        // Create the screen and UI
 void AppWeather_Update();      // Fetch new data from internet
+bool AppWeather_Fetch(WeatherReading *out);     // HTTP + JSON only, no LVGL: callable from the network task
+void AppWeather_Show(const WeatherReading *r);  // Put a reading on the screen (LVGL task)
 lv_obj_t* AppWeather_GetScreen(); // Get the screen pointer for navigation
 
 #endif
\ No newline at end of file
@@ -0,0 +1,20 @@
+#ifndef ASSET_STORE_H
+#define ASSET_STORE_H
+
+#include <lvgl.h>
+
+// Build options - override from platformio.ini build_flags (tools/asset_pipeline.py reads them too)
+#ifndef WATCH_ASSET_STORE
+#define WATCH_ASSET_STORE 1 // 1 = images come from the "assets" flash partition, 0 = compiled into the app
+#endif
+
+#define ASSET_STORE_MAX 16 // Entries in the pack (tools/asset_pack.py)
+
+// Images in the "assets" partition (container: tools/asset_pack.py). The partition is
+// memory-mapped once; descriptors point straight into the mapping, nothing is copied.
+// Off target (no ARDUINO) the same code maps the file named by $ASSET_STORE_FILE.
+bool AssetStore_Mount();                              // Map + validate (CRC) on the first call; false if missing or corrupt
+const lv_img_dsc_t *AssetStore_Image(const char *name); // NULL if not mounted or not in the pack
+const lv_img_dsc_t *AssetStore_At(int index, const char **name); // Entries in pack order; NULL past the end
+
+#endif
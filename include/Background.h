@@ -0,0 +1,24 @@
+#ifndef BACKGROUND_H
+#define BACKGROUND_H
+
+#include <lvgl.h>
+
+// Storage formats for the watch-face photo, produced by tools/asset_pipeline.py
+#define BG_FORMAT_RAW 0      // 64,800-byte RGB565 array drawn straight from flash
+#define BG_FORMAT_Q565 1     // QOI-style stream with a row table (~31 KB), decoded row by row, lossless
+#define BG_FORMAT_INDEXED8 2 // 256-colour palette + ordered dither (33.4 KB), lossy
+#define BG_FORMAT_COUNT 3
+
+// Build options - override from platformio.ini build_flags
+#ifndef WATCH_BG_FORMAT
+#define WATCH_BG_FORMAT BG_FORMAT_Q565 // Only this format is linked (all of them with DISPLAY_BENCH)
+#endif
+
+void Background_Init();                                          // Register the image decoder (after lv_init)
+lv_obj_t *Background_Create(lv_obj_t *parent, int format);      // Full-screen image of the photo
+const lv_img_dsc_t *Background_Image(int format);                // NULL if format is not linked
+void Background_SetFace(const lv_img_dsc_t *face);              // Opaque RAM image shown instead of the photo, NULL = photo
+void Background_ReadRow(int y, int x, int len, lv_color_t *out); // Pixels of the shown image, LVGL byte order
+void Background_RunBenchmark();                                  // Decode/render time and error per format (Serial)
+
+#endif
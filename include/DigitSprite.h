@@ -0,0 +1,23 @@
+#ifndef DIGIT_SPRITE_H
+#define DIGIT_SPRITE_H
+
+#include <lvgl.h>
+
+// Build options - override from platformio.ini build_flags
+#ifndef WATCH_DIGIT_SPRITES
+#define WATCH_DIGIT_SPRITES 1 // 1 = clock/timer digits are pre-rasterized A8 cells, 0 = plain lv_label
+#endif
+
+#define DIGIT_SPRITE_MAX_CELLS 8 // Characters per text ("HH:MM:SS")
+#define DIGIT_SPRITE_MAX_TEXTS 4 // Live sprite texts
+#define DIGIT_SPRITE_MAX_FONTS 2 // Fonts with a glyph cache (24 and 48 px)
+
+// Text of '0'-'9' and ':' (anything else is a blank digit cell). Digits get the width of
+// the widest one, so the text never reflows and only changed cells are redrawn.
+// The glyph cells of a font are rasterized on first use and kept.
+lv_obj_t *DigitSprite_Create(lv_obj_t *parent, const lv_font_t *font, const char *text);
+void DigitSprite_SetText(lv_obj_t *obj, const char *text); // Invalidates the changed cells only
+void DigitSprite_SetColor(lv_obj_t *obj, lv_color_t color);
+void DigitSprite_RunBenchmark(); // Timer second and clock minute: sprites vs labels (Serial)
+
+#endif
@@ -0,0 +1,197 @@
+#ifndef DISPLAY_H
+#define DISPLAY_H
+
+#include <lvgl.h>
+
+// Panel geometry (portrait, rotation 2). TFT_WIDTH/TFT_HEIGHT are set per environment in
+// platformio.ini and read by TFT_eSPI as well; every screen layout, game grid and buffer
+// size is derived from DISPLAY_WIDTH/DISPLAY_HEIGHT.
+#ifndef TFT_WIDTH
+#define TFT_WIDTH 135
+#endif
+#ifndef TFT_HEIGHT
+#define TFT_HEIGHT 240
+#endif
+#define DISPLAY_WIDTH TFT_WIDTH
+#define DISPLAY_HEIGHT TFT_HEIGHT
+#define DISPLAY_ROTATION 2
+// Colour inversion the panel runs with (IPS ST7789 modules need INVON for true colours);
+// sent by Display_BeginPanel so it does not depend on the driver's init sequence
+#ifdef TFT_INVERSION_OFF
+#define DISPLAY_INVERTED 0
+#else
+#define DISPLAY_INVERTED 1
+#endif
+#define DISPLAY_BUF_LINES (DISPLAY_HEIGHT / 6)                  // Rows per draw stripe: 6 stripes a frame, 40 on 240 px
+#define DISPLAY_BUF_PIXELS (DISPLAY_WIDTH * DISPLAY_BUF_LINES)   // Per LVGL draw buffer
+
+// ST7789 frame memory: 320 lines; the visible ones start at TFT_eSPI's rowstart for rotation 2
+#define DISPLAY_GRAM_ROWS 320
+#if DISPLAY_WIDTH == 135 && DISPLAY_HEIGHT == 240
+#define DISPLAY_GRAM_ROW_OFFSET 40 // 1.14" 135x240, centred in frame memory
+#elif DISPLAY_WIDTH == 240 && DISPLAY_HEIGHT == 240
+#define DISPLAY_GRAM_ROW_OFFSET 80 // 1.3" 240x240, frame memory lines 80..319
+#elif DISPLAY_WIDTH == 240 && DISPLAY_HEIGHT == 320
+#define DISPLAY_GRAM_ROW_OFFSET 0 // 2.0" 240x320, all of frame memory
+#else
+#error "Unsupported panel: TFT_WIDTH x TFT_HEIGHT must be 135x240, 240x240 or 240x320"
+#endif
+
+// ST7789 commands used outside TFT_eSPI
+#ifndef ST7789_PTLON
+#define ST7789_PTLON 0x12 // Partial display mode on
+#endif
+#ifndef ST7789_NORON
+#define ST7789_NORON 0x13 // Normal display mode on (leaves partial mode)
+#endif
+#ifndef ST7789_INVOFF
+#define ST7789_INVOFF 0x20 // Display inversion off
+#endif
+#ifndef ST7789_INVON
+#define ST7789_INVON 0x21 // Display inversion on
+#endif
+#ifndef ST7789_DISPOFF
+#define ST7789_DISPOFF 0x28 // Blank the panel, frame memory is kept
+#endif
+#ifndef ST7789_DISPON
+#define ST7789_DISPON 0x29 // Show frame memory again
+#endif
+#ifndef ST7789_PTLAR
+#define ST7789_PTLAR 0x30 // Partial area start/end line
+#endif
+#ifndef ST7789_IDMOFF
+#define ST7789_IDMOFF 0x38 // Idle mode off (full colour)
+#endif
+#ifndef ST7789_IDMON
+#define ST7789_IDMON 0x39 // Idle mode on (8 colours)
+#endif
+#ifndef ST7789_VSCRDEF
+#define ST7789_VSCRDEF 0x33 // Vertical scroll definition
+#endif
+#ifndef ST7789_VSCSAD
+#define ST7789_VSCSAD 0x37 // Vertical scroll start address
+#endif
+#ifndef ST7789_COLMOD
+#define ST7789_COLMOD 0x3A // Interface pixel format
+#endif
+#define DISPLAY_COLMOD_16BIT 0x55 // RGB565, 2 bytes per pixel
+#define DISPLAY_COLMOD_12BIT 0x53 // RGB444, 3 bytes per 2 pixels
+
+// Build options - override from platformio.ini build_flags
+#ifndef DISPLAY_DMA_FLUSH
+#define DISPLAY_DMA_FLUSH 1 // 1 = double buffer + DMA flush, 0 = single buffer + blocking pushColors
+#endif
+
+#ifndef DISPLAY_SHADOW_FB
+#define DISPLAY_SHADOW_FB 0 // 1 = keep a copy of the panel (64,800 bytes at 135x240) and only send changed spans
+#endif
+
+#ifndef DISPLAY_HW_SCROLL
+#define DISPLAY_HW_SCROLL 1 // 1 = page transitions use the ST7789 vertical scroll, 0 = LVGL slide animation
+#endif
+#if DISPLAY_HW_SCROLL && DISPLAY_HEIGHT >= DISPLAY_GRAM_ROWS
+// The incoming page is drawn into frame memory rows off screen; a 320-line panel has none
+#undef DISPLAY_HW_SCROLL
+#define DISPLAY_HW_SCROLL 0
+#endif
+
+#ifndef DISPLAY_12BIT
+#define DISPLAY_12BIT 1 // 1 = allow the 12-bit transport (adds an 8 KB pack buffer), 0 = always RGB565
+#endif
+
+#ifndef DISPLAY_AREA_MERGE
+#define DISPLAY_AREA_MERGE 1 // 1 = merge invalid areas by the cost model below + pair-align them, 0 = LVGL's own join only
+#endif
+
+// The area merge and the scroll transition edit lv_disp_t's invalid area list (inv_areas,
+// inv_area_joined, inv_p), which is LVGL-internal; its layout is the one of LVGL 8.3
+#define DISPLAY_LVGL_AREA_LIST (LVGL_VERSION_MAJOR == 8 && LVGL_VERSION_MINOR == 3)
+#if DISPLAY_AREA_MERGE && !DISPLAY_LVGL_AREA_LIST
+#undef DISPLAY_AREA_MERGE
+#define DISPLAY_AREA_MERGE 0
+#endif
+
+// Cost model for DISPLAY_AREA_MERGE: each LVGL stripe costs a fixed render/flush/window
+// setup plus a per-pixel render+wire time. The defaults are estimates for 40 MHz SPI;
+// DISPLAY_BENCH measures this panel, applies the result and prints it for build_flags.
+#ifndef DISPLAY_AREA_COST_US
+#define DISPLAY_AREA_COST_US 150
+#endif
+#ifndef DISPLAY_PX_COST_NS
+#define DISPLAY_PX_COST_NS 450
+#endif
+
+#ifndef DISPLAY_STATS
+#define DISPLAY_STATS 0 // 1 = print flush statistics to Serial periodically
+#endif
+
+#ifndef DISPLAY_BENCH
+#define DISPLAY_BENCH 0 // 1 = run the flush throughput benchmark once at boot
+#endif
+
+// Pixel format on the SPI bus. LVGL always renders RGB565; RGB444 is packed in the flush.
+enum DisplayTransport
+{
+    DISPLAY_RGB565,
+    DISPLAY_RGB444,
+};
+
+struct DisplayStats
+{
+    unsigned long flushes;    // Number of flush_cb calls (stripes)
+    unsigned long pixels;     // Pixels handed to the panel
+    unsigned long flush_us;   // CPU time spent inside flush_cb
+    unsigned long render_us;  // Time LVGL spent rendering stripes that followed a flush
+    unsigned long wait_us;    // Time LVGL sat blocked waiting for the bus
+    unsigned long overlap_us; // Render time that ran while the previous stripe was on the wire
+    unsigned long wire_us;    // Estimated SPI wire time of the overlappable stripes
+    unsigned long refreshes;  // LVGL refresh cycles that redrew something
+    unsigned long refresh_ms; // Total render+flush time of those refreshes
+    unsigned long refresh_max_ms;
+    unsigned long areas;        // Invalid areas rendered after merging
+    unsigned long areas_merged; // Areas folded into a neighbour by the cost model
+    unsigned long shadow_bytes_in;   // Bytes LVGL flushed while the shadow framebuffer was active
+    unsigned long shadow_bytes_sent; // Bytes that actually went to the panel after diffing
+};
+
+// Receives a rendered full-width stripe of rows y..y+h-1 in LVGL byte order
+typedef void (*DisplayCaptureSink)(int y, int h, const uint16_t *pixels, void *ctx);
+
+void Display_BeginPanel(); // Panel only, usable before lv_init (boot snapshot)
+void Display_Init();       // Bring up the panel if needed and register the LVGL display driver
+bool Display_Poll();     // Retire a finished DMA transfer (call from loop); true when the bus is idle
+void Display_WaitIdle();  // Block until the bus is free (before talking to the panel directly)
+void Display_InvalidatePanel();                          // Panel was drawn outside LVGL: resend everything
+void Display_NameScreen(lv_obj_t *scr, const char *name); // Label a screen in the per-app statistics
+void Display_PushFrame(const uint16_t *pixels);          // Blocking full-frame write, LVGL byte order
+void Display_Capture(DisplayCaptureSink sink, void *ctx); // Redraw the active screen through sink
+unsigned long Display_FirstFrameUs();                     // micros() when LVGL finished its first refresh
+void Display_RenderArea(const lv_area_t *area, uint16_t *pixels);     // Render area of the active screen into RAM, panel untouched
+void Display_PushArea(const lv_area_t *area, const uint16_t *pixels); // Blocking write of a rendered area, LVGL byte order
+
+// LVGL refresh timer
+void Display_SetRefreshPeriod(uint32_t period_ms); // How often LVGL looks for invalid areas
+void Display_RefreshSoon();                        // Render on the next lv_timer_handler, whatever the period
+
+// Raw panel commands - no pixel traffic
+void Display_Command(uint8_t cmd);
+void Display_CommandData(uint8_t cmd, const uint8_t *data, int len);
+
+// Bus pixel format - switch between refreshes, e.g. on app enter/exit
+void Display_SetTransport(DisplayTransport mode);
+DisplayTransport Display_GetTransport();
+
+// Hardware scroll primitives (used by Transition)
+void Display_SetScrollOffset(int view_line); // Show virtual frame memory line view_line at the top
+int Display_GetRowBase();
+void Display_SetRowBase(int base);           // Virtual line that logical row 0 is written to
+void Display_SetRowClip(int y1, int y2);     // Only write logical rows y1..y2, remember the rest
+bool Display_EndRowClip(lv_area_t *dropped); // Lift the clip; true + rows if anything was refused
+void Display_ResetScroll();                  // Back to row base 0 / scroll offset 0 (redraw follows)
+void Display_SetAreaCost(unsigned long area_us, unsigned long px_ns); // Retune the merge cost model
+void Display_GetStats(DisplayStats *out);
+void Display_ResetStats();
+void Display_PrintStats();
+void Display_RunBenchmark();
+
+#endif
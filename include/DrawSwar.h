@@ -0,0 +1,16 @@
+#ifndef DRAW_SWAR_H
+#define DRAW_SWAR_H
+
+#include <lvgl.h>
+
+// Build options - override from platformio.ini build_flags
+#ifndef DRAW_SWAR
+#define DRAW_SWAR 1 // 1 = RGB565 fill/blend kernels working on pixel pairs in IRAM, 0 = stock lv_draw_sw
+#endif
+
+// Software draw context whose blend step handles two RGB565 pixels per 32-bit word.
+// Everything it does not cover (other blend modes, set_px_cb) goes to lv_draw_sw_blend_basic.
+void DrawSwar_Init(lv_disp_drv_t *drv); // Call before lv_disp_drv_register
+void DrawSwar_RunBenchmark();           // Time each kernel against the stock renderer (Serial)
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef FONTS_H
+#define FONTS_H
+
+#include <lvgl.h>
+
+// Build options - override from platformio.ini build_flags (tools/asset_pipeline.py reads them too)
+#ifndef WATCH_FONT_SUBSET
+#define WATCH_FONT_SUBSET 0 // 1 = Montserrat cut down to the glyphs in FONT_SUBSETS (tools/font_subset.py, check with test/test_font_subset.py), 0 = LVGL's full fonts
+#endif
+
+#ifndef WATCH_FONT_COMPRESSED
+#define WATCH_FONT_COMPRESSED 0 // 1 = subset bitmaps in LVGL's RLE format (smaller flash, slower glyph fetch)
+#endif
+
+// Fonts the UI draws with. Glyphs outside a subset are not in the image.
+#if WATCH_FONT_SUBSET
+#ifdef __cplusplus
+extern "C" {
+#endif
+LV_FONT_DECLARE(watch_font_14) // Printable ASCII, degree sign, the LV_SYMBOLs used in status lines
+LV_FONT_DECLARE(watch_font_24) // Digits, capitals, " -.:°"
+LV_FONT_DECLARE(watch_font_48) // Digits, ':' and '-'
+#ifdef __cplusplus
+}
+#endif
+#define WATCH_FONT_14 (&watch_font_14)
+#define WATCH_FONT_24 (&watch_font_24)
+#define WATCH_FONT_48 (&watch_font_48)
+#else
+#define WATCH_FONT_14 (&lv_font_montserrat_14)
+#define WATCH_FONT_24 (&lv_font_montserrat_24)
+#define WATCH_FONT_48 (&lv_font_montserrat_48)
+#endif
+
+#ifdef __cplusplus
+void Fonts_RunBenchmark(); // Glyph fetch time and bitmap check, subset vs full font (Serial)
+#endif
+
+#endif
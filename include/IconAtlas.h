@@ -0,0 +1,31 @@
+#ifndef ICON_ATLAS_H
+#define ICON_ATLAS_H
+
+#include <lvgl.h>
+
+// Build options - override from platformio.ini build_flags (tools/asset_pipeline.py reads them too)
+#ifndef WEATHER_ICON_FORMAT
+#define WEATHER_ICON_FORMAT 1 // 0 = RGB565 + alpha, 1 = opaque, pre-blended on WEATHER_ICON_BG, 2 = A8 masks, tinted
+#endif
+
+#ifndef WEATHER_ICON_BG
+#define WEATHER_ICON_BG 0x000000 // Weather screen background the opaque icons are blended onto
+#endif
+
+// Atlas order - must match ICON_NAMES in tools/asset_pipeline.py
+enum WeatherIcon
+{
+    WEATHER_ICON_CLEAR,
+    WEATHER_ICON_WIND,
+    WEATHER_ICON_STORMY,
+    WEATHER_ICON_CLOUDY,
+    WEATHER_ICON_TEMP,
+    WEATHER_ICON_RAINY,
+    WEATHER_ICON_COUNT
+};
+
+const lv_img_dsc_t *IconAtlas_Get(WeatherIcon icon);
+lv_obj_t *IconAtlas_Create(lv_obj_t *parent, WeatherIcon icon);
+void IconAtlas_Set(lv_obj_t *img, WeatherIcon icon); // Source + tint for A8 masks
+
+#endif
@@ -0,0 +1,17 @@
+#ifndef PANEL_FX_H
+#define PANEL_FX_H
+
+#include <lvgl.h>
+
+// Full-screen effects done with ST7789 commands instead of redrawing pixels
+void PanelFx_Flash(uint16_t count, uint32_t period_ms); // Invert/restore `count` times, period_ms per phase
+void PanelFx_Stop();                                    // Cancel a flash and restore the normal image
+void PanelFx_SetInverted(bool on);
+void PanelFx_SetBlanked(bool on); // Panel dark, frame memory kept
+
+// Low-power panel modes
+void PanelFx_SetPartial(int y1, int y2); // Only drive logical rows y1..y2 (PTLAR + PTLON)
+void PanelFx_SetNormal();                // Drive the whole panel again (NORON)
+void PanelFx_SetIdle(bool on);           // 8-colour idle mode (IDMON/IDMOFF)
+
+#endif
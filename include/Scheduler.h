@@ -0,0 +1,34 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdint.h>
+
+// Build options - override from platformio.ini build_flags
+#ifndef WATCH_TICKLESS
+#define WATCH_TICKLESS 1 // 1 = loop sleeps until the earliest job/LVGL deadline, 0 = fixed delay(10) polling
+#endif
+
+#define SCHEDULER_MAX_JOBS 8
+#define SCHEDULER_OFF 0xFFFFFFFFUL // Period / delay of a job that only runs when rescheduled
+
+// Deadline-driven jobs for the main loop. Deadlines are millis() values; a periodic job is
+// due again period_ms after its run finished, like the fixed delay it replaces.
+typedef void (*SchedulerJob)();
+
+struct SchedulerStats
+{
+    unsigned long wakeups;       // Scheduler_Sleep returns
+    unsigned long early_wakeups; // Ended by Scheduler_Wake before the deadline
+    unsigned long runs;          // Job runs
+};
+
+int Scheduler_Add(SchedulerJob job, uint32_t period_ms); // First run period_ms from now; returns the job id
+void Scheduler_SetPeriod(int id, uint32_t period_ms);  // Re-based on now when it changes; SCHEDULER_OFF stops
+void Scheduler_In(int id, uint32_t delay_ms);          // Next run only (0 = on this pass), period unchanged
+uint32_t Scheduler_RunDue();                           // Run every due job; ms until the earliest deadline
+void Scheduler_Sleep(uint32_t ms);                     // Block the calling task until ms passed or a wake
+void Scheduler_Wake();                                 // End the sleep early (from a task)
+void Scheduler_GetStats(SchedulerStats *out);
+void Scheduler_ResetStats();
+
+#endif
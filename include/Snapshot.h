@@ -0,0 +1,20 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <lvgl.h>
+
+// Build options - override from platformio.ini build_flags
+#ifndef WATCH_SNAPSHOT
+#define WATCH_SNAPSHOT 1 // 1 = show the last saved home frame at boot before LVGL starts
+#endif
+
+#ifndef WATCH_SNAPSHOT_INTERVAL_MIN
+#define WATCH_SNAPSHOT_INTERVAL_MIN 60 // Minimum minutes between saves (each one erases 64 KB of flash)
+#endif
+
+// Last home frame kept in the "snapshot" flash partition (see partitions.csv)
+bool Snapshot_Show();       // Push the stored frame to the panel; call right after Display_BeginPanel
+void Snapshot_SaveIfDue();  // Capture the active screen if the save interval has passed
+void Snapshot_ReportBoot(); // Print boot-to-first-pixel for the snapshot and for LVGL
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef TASKS_H
+#define TASKS_H
+
+#include <Arduino.h>
+
+// Build options - override from platformio.ini build_flags
+#ifndef WATCH_TASKS
+#define WATCH_TASKS 1 // 1 = input and network run in their own pinned tasks, 0 = everything in loop()
+#endif
+
+// Cores: WiFi/lwIP already live on PRO_CPU, LVGL and the apps keep the Arduino loop on APP_CPU
+#define TASKS_NET_CORE 0
+#define TASKS_UI_CORE 1
+
+#define TASKS_MAX 6
+
+// Registry of the firmware's tasks for the CPU / stack report. "Active" time is what each
+// task accounts between waking and blocking again, so it includes waits inside calls
+// (SPI, HTTP) and time preempted by higher-priority tasks.
+int Tasks_Start(const char *name, TaskFunction_t body, uint32_t stack_bytes, UBaseType_t priority, BaseType_t core);
+int Tasks_Adopt(const char *name, uint32_t stack_bytes); // Register the calling task (the Arduino loop)
+void Tasks_AddActive(int id, uint32_t us);
+void Tasks_PrintStats(); // Active % since the last call and lowest free stack per task (Serial)
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef THEME_H
+#define THEME_H
+
+#include <lvgl.h>
+
+#define THEME_BRICK_ROWS 6 // One brick style per Breakout row
+
+// Build options - override from platformio.ini build_flags
+#ifndef WATCH_SCREEN_GEN
+#define WATCH_SCREEN_GEN 1 // 1 = app screens built by code generated from screens/*.json (tools/screen_gen.py), 0 = hand-written builders
+#endif
+
+// Shared static styles. Each lv_style_t exists once and objects only hold a pointer to it,
+// instead of every object carrying its own local style with the same properties.
+enum ThemeStyle
+{
+    THEME_HEADER,      // Game header bar
+    THEME_FRAME,       // Game playfield: 2 px border (colours set per app)
+    THEME_TITLE,       // 24 px header text
+    THEME_TEXT,        // 14 px white text
+    THEME_CAPTION,     // 14 px grey values (home date, weather)
+    THEME_STATUS,      // 14 px centred status text
+    THEME_SNAKE_CELL,
+    THEME_SNAKE_FOOD,
+    THEME_PADDLE,
+    THEME_BALL,
+    THEME_BRICK,       // + row, THEME_BRICK_ROWS styles
+    THEME_COUNT = THEME_BRICK + THEME_BRICK_ROWS
+};
+
+void Theme_Init();                                           // After lv_init, before the screens are built
+void Theme_Apply(lv_obj_t *obj, int style);                  // lv_obj_add_style on the main part
+lv_obj_t *Theme_CreateSprite(lv_obj_t *parent, int style);   // Plain object without the default theme's styles
+void Theme_RunBenchmark();                                   // LVGL heap and style resolution, local vs shared (Serial)
+
+#endif
@@ -0,0 +1,14 @@
+#ifndef TRANSITION_H
+#define TRANSITION_H
+
+#include <lvgl.h>
+
+#define TRANSITION_TIME 300 // ms, same as the LVGL slide it replaces
+
+// Drop-in for lv_scr_load_anim(scr, anim, TRANSITION_TIME, 0, false).
+// With DISPLAY_HW_SCROLL the panel scrolls vertically: MOVE_LEFT brings the new
+// screen up from the bottom, MOVE_RIGHT brings it down from the top.
+void Transition_Load(lv_obj_t *scr, lv_scr_load_anim_t anim);
+bool Transition_IsRunning();
+
+#endif
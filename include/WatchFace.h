@@ -0,0 +1,29 @@
+#ifndef WATCH_FACE_H
+#define WATCH_FACE_H
+
+#include <lvgl.h>
+
+// Build options - override from platformio.ini build_flags (tools/asset_pipeline.py reads them too)
+#ifndef WATCH_FACES
+#define WATCH_FACES 1 // 1 = extra JPEG home faces from the asset store (UP/DOWN on home), 0 = the photo only
+#endif
+
+#ifndef WATCH_FACE_CACHE_MAX
+#define WATCH_FACE_CACHE_MAX 98304 // Largest decoded face (one contiguous internal-RAM block without PSRAM); above it, no JPEG faces
+#endif
+
+#define WATCH_FACE_MAX 8 // Built-in photo + JPEG faces
+
+// Selectable home backgrounds. Face 0 is the built-in photo (WATCH_BG_FORMAT, drawn from
+// flash). Faces 1.. are the baseline JPEGs "face_*" in the asset store; the selected one is
+// decoded once into a single RGB565 cache that exists only while a JPEG face is shown.
+// The choice is kept in NVS.
+void WatchFace_Init();                // After Background_Init, before the home screen is built
+int WatchFace_Count();
+int WatchFace_Current();
+const char *WatchFace_Name(int face); // "photo" for face 0
+bool WatchFace_Select(int face);      // false if the JPEG could not be decoded (the photo is shown then)
+bool WatchFace_Step(int delta);       // Next/previous face, wrapping
+void WatchFace_RunBenchmark();        // Decode time and heap per face (Serial)
+
+#endif
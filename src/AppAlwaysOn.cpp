@@ -0,0 +1,92 @@
+#include <Arduino.h>
+#include <time.h>
+#include "AppAlwaysOn.h"
+#include "Display.h"
+#include "PanelFx.h"
+#include "Fonts.h"
+#include "Theme.h"
+
+// Only this band of rows is driven in partial mode (70..169 on 240 px)
+#define AOD_BAND_Y1 (DISPLAY_HEIGHT / 2 - 50)
+#define AOD_BAND_Y2 (AOD_BAND_Y1 + 99)
+
+static lv_obj_t *aod_screen;
+static lv_obj_t *time_label;
+static lv_obj_t *date_label;
+
+static bool active = false;
+static int last_minute = -1;
+
+void AppAlwaysOn_Init()
+{
+    // Pure black/white only: idle mode shows 8 colours
+    aod_screen = lv_obj_create(NULL);
+    lv_obj_set_style_bg_color(aod_screen, lv_color_hex(0x000000), 0);
+
+    time_label = lv_label_create(aod_screen);
+    lv_obj_set_style_text_font(time_label, WATCH_FONT_48, 0);
+    lv_obj_set_style_text_color(time_label, lv_color_hex(0xFFFFFF), 0);
+    lv_label_set_text(time_label, "--:--");
+    lv_obj_align(time_label, LV_ALIGN_TOP_MID, 0, AOD_BAND_Y1 + 10);
+
+    date_label = lv_label_create(aod_screen);
+    Theme_Apply(date_label, THEME_TEXT);
+    lv_label_set_text(date_label, "");
+    lv_obj_align(date_label, LV_ALIGN_TOP_MID, 0, AOD_BAND_Y1 + 70);
+}
+
+void AppAlwaysOn_Update()
+{
+    if (!active)
+        return;
+
+    struct tm timeinfo;
+    if (!getLocalTime(&timeinfo, 0) || timeinfo.tm_min == last_minute)
+        return;
+    last_minute = timeinfo.tm_min;
+
+    char buf_time[10];
+    strftime(buf_time, sizeof(buf_time), "%H:%M", &timeinfo);
+    lv_label_set_text(time_label, buf_time);
+
+    char buf_date[20];
+    strftime(buf_date, sizeof(buf_date), "%a, %d %b", &timeinfo);
+    lv_label_set_text(date_label, buf_date);
+
+    // lv_timer_handler is not running in this mode; render the one change now
+    lv_refr_now(NULL);
+}
+
+void AppAlwaysOn_Enter()
+{
+    if (active)
+        return;
+    active = true;
+    last_minute = -1;
+
+    // Partial mode addresses fixed frame memory lines, so drop any scroll offset first
+    Display_ResetScroll();
+    lv_scr_load(aod_screen);
+    AppAlwaysOn_Update();
+    lv_refr_now(NULL);
+
+    PanelFx_SetPartial(AOD_BAND_Y1, AOD_BAND_Y2);
+    PanelFx_SetIdle(true);
+}
+
+void AppAlwaysOn_Exit(lv_obj_t *screen)
+{
+    if (!active)
+        return;
+    active = false;
+
+    PanelFx_SetIdle(false);
+    PanelFx_SetNormal();
+    lv_scr_load(screen);
+    lv_refr_now(NULL);
+}
+
+bool AppAlwaysOn_IsActive()
+{
+    return active;
+}
@@ -1,26 +1,30 @@
 #include <Arduino.h>
 #include "AppBreakout.h"
+#include "PanelFx.h"
+#include "Display.h"
+#include "Theme.h"
 
-// Game constants
-#define GAME_WIDTH 115
-#define GAME_HEIGHT 176
+// Game constants - the field fills the display below the header
+#define HEADER_HEIGHT 50
 #define GAME_OFFSET_X 10
-#define GAME_OFFSET_Y 55
+#define GAME_OFFSET_Y (HEADER_HEIGHT + 5)
+#define GAME_WIDTH (DISPLAY_WIDTH - 2 * GAME_OFFSET_X)     // 115 on 135 px
+#define GAME_HEIGHT (DISPLAY_HEIGHT - GAME_OFFSET_Y - 9)    // 176 on 240 px
 
-#define PADDLE_WIDTH 30
+#define PADDLE_WIDTH (GAME_WIDTH * 6 / 23) // 30 on the 115 px field
 #define PADDLE_HEIGHT 5
-#define PADDLE_Y 165
+#define PADDLE_Y (GAME_HEIGHT - 11)
 #define PADDLE_SPEED 15
 
 #define BALL_SIZE 5
 #define BALL_SPEED 1.3
 
-#define BRICK_ROWS 6
+#define BRICK_ROWS THEME_BRICK_ROWS
 #define BRICK_COLS 8
-#define BRICK_WIDTH 13
-#define BRICK_HEIGHT 8
 #define BRICK_SPACING 1
-#define BRICK_OFFSET_X 11
+#define BRICK_WIDTH ((GAME_WIDTH - 4 - (BRICK_COLS - 1) * BRICK_SPACING) / BRICK_COLS) // 13 on 135 px
+#define BRICK_HEIGHT 8
+#define BRICK_OFFSET_X (GAME_OFFSET_X + 1)
 #define BRICK_OFFSET_Y 60
 
 // Game state
@@ -33,6 +37,10 @@ static lv_obj_t *paddle;
 static lv_obj_t *ball;
 static lv_obj_t *bricks[BRICK_ROWS][BRICK_COLS];
 
+#if WATCH_SCREEN_GEN
+#include "screen_breakout.h" // From screens/breakout.json
+#endif
+
 static bool game_active = false;
 static bool game_started = false;
 static float paddle_x = (GAME_WIDTH - PADDLE_WIDTH) / 2;
@@ -46,100 +54,75 @@ static int bricks_remaining = 0;
 static bool brick_active[BRICK_ROWS][BRICK_COLS];
 static unsigned long game_over_time = 0;
 
-// Colors for brick rows (rainbow pattern)
-static const uint32_t brick_colors[BRICK_ROWS] = {
-    0xFF0000,  // Red
-    0xFF7F00,  // Orange
-    0xFFFF00,  // Yellow
-    0x00FF00,  // Green
-    0x0000FF,  // Blue
-    0x8B00FF   // Purple
-};
-
 // Forward declarations
 void AppBreakout_GameOver();
 void AppBreakout_ResetBall();
 void AppBreakout_Win();
 
 void AppBreakout_Init() {
+#if WATCH_SCREEN_GEN
+    screen_build_breakout();
+#else
     breakout_screen = lv_obj_create(NULL);
     lv_obj_set_style_bg_color(breakout_screen, lv_color_hex(0x0a0a0a), 0);
 
     // Header
-    lv_obj_t *header = lv_obj_create(breakout_screen);
-    lv_obj_set_size(header, 135, 50);
+    lv_obj_t *header = Theme_CreateSprite(breakout_screen, THEME_HEADER);
+    lv_obj_set_size(header, DISPLAY_WIDTH, HEADER_HEIGHT);
     lv_obj_set_pos(header, 0, 0);
-    lv_obj_set_style_bg_color(header, lv_color_hex(0x1a1a2e), 0);
-    lv_obj_set_style_border_width(header, 0, 0);
-    lv_obj_set_style_pad_all(header, 0, 0);
-    lv_obj_set_style_radius(header, 0, 0);
 
     // Title
     lv_obj_t *title = lv_label_create(header);
     lv_label_set_text(title, "BREAKOUT");
-    lv_obj_set_style_text_font(title, &lv_font_montserrat_24, 0);
+    Theme_Apply(title, THEME_TITLE);
     lv_obj_set_style_text_color(title, lv_color_hex(0xFF00FF), 0);
     lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 3);
 
     // Score
     score_label = lv_label_create(header);
     lv_label_set_text(score_label, "Score: 0");
-    lv_obj_set_style_text_font(score_label, &lv_font_montserrat_14, 0);
-    lv_obj_set_style_text_color(score_label, lv_color_hex(0xFFFFFF), 0);
+    Theme_Apply(score_label, THEME_TEXT);
     lv_obj_align(score_label, LV_ALIGN_BOTTOM_LEFT, 5, -3);
 
     // Lives
     lives_label = lv_label_create(header);
     lv_label_set_text(lives_label, "Lives: 3");
-    lv_obj_set_style_text_font(lives_label, &lv_font_montserrat_14, 0);
-    lv_obj_set_style_text_color(lives_label, lv_color_hex(0xFFFFFF), 0);
+    Theme_Apply(lives_label, THEME_TEXT);
     lv_obj_align(lives_label, LV_ALIGN_BOTTOM_RIGHT, -5, -3);
 
     // Game area background
-    game_area = lv_obj_create(breakout_screen);
+    game_area = Theme_CreateSprite(breakout_screen, THEME_FRAME);
     lv_obj_set_size(game_area, GAME_WIDTH + 4, GAME_HEIGHT + 4);
     lv_obj_set_pos(game_area, GAME_OFFSET_X - 2, GAME_OFFSET_Y - 2);
     lv_obj_set_style_bg_color(game_area, lv_color_hex(0x000000), 0);
     lv_obj_set_style_border_color(game_area, lv_color_hex(0xFF00FF), 0);
-    lv_obj_set_style_border_width(game_area, 2, 0);
-    lv_obj_set_style_pad_all(game_area, 0, 0);
-    lv_obj_set_style_radius(game_area, 0, 0);
 
     // Status label
     status_label = lv_label_create(breakout_screen);
     lv_label_set_text(status_label, "Press " LV_SYMBOL_PLAY "\nto Start\n\n" LV_SYMBOL_LEFT LV_SYMBOL_RIGHT " Navigate");
+    Theme_Apply(status_label, THEME_STATUS);
     lv_obj_set_style_text_color(status_label, lv_color_hex(0xFF00FF), 0);
-    lv_obj_set_style_text_align(status_label, LV_TEXT_ALIGN_CENTER, 0);
-    lv_obj_set_style_text_font(status_label, &lv_font_montserrat_14, 0);
     lv_obj_align(status_label, LV_ALIGN_CENTER, 0, 30);
 
     // Paddle
-    paddle = lv_obj_create(breakout_screen);
+    paddle = Theme_CreateSprite(breakout_screen, THEME_PADDLE);
     lv_obj_set_size(paddle, PADDLE_WIDTH, PADDLE_HEIGHT);
-    lv_obj_set_style_bg_color(paddle, lv_color_hex(0x00FFFF), 0);
-    lv_obj_set_style_border_width(paddle, 0, 0);
-    lv_obj_set_style_radius(paddle, 2, 0);
     lv_obj_add_flag(paddle, LV_OBJ_FLAG_HIDDEN);
 
     // Ball
-    ball = lv_obj_create(breakout_screen);
+    ball = Theme_CreateSprite(breakout_screen, THEME_BALL);
     lv_obj_set_size(ball, BALL_SIZE, BALL_SIZE);
-    lv_obj_set_style_bg_color(ball, lv_color_hex(0xFFFFFF), 0);
-    lv_obj_set_style_border_width(ball, 0, 0);
-    lv_obj_set_style_radius(ball, BALL_SIZE/2, 0);
     lv_obj_add_flag(ball, LV_OBJ_FLAG_HIDDEN);
 
-    // Create bricks
+    // Create bricks - one shared style per row
     for(int row = 0; row < BRICK_ROWS; row++) {
         for(int col = 0; col < BRICK_COLS; col++) {
-            bricks[row][col] = lv_obj_create(breakout_screen);
+            bricks[row][col] = Theme_CreateSprite(breakout_screen, THEME_BRICK + row);
             lv_obj_set_size(bricks[row][col], BRICK_WIDTH, BRICK_HEIGHT);
-            lv_obj_set_style_bg_color(bricks[row][col], lv_color_hex(brick_colors[row]), 0);
-            lv_obj_set_style_border_width(bricks[row][col], 0, 0);
-            lv_obj_set_style_radius(bricks[row][col], 1, 0);
             lv_obj_add_flag(bricks[row][col], LV_OBJ_FLAG_HIDDEN);
         }
     }
+#endif
 }
 
 void AppBreakout_Enter() {
@@ -200,12 +183,15 @@ void AppBreakout_Start() {
     // Update UI
     lv_label_set_text(score_label, "Score: 0");
     lv_label_set_text(lives_label, "Lives: 3");
+    Display_SetTransport(DISPLAY_RGB444); // Fast play, colour depth matters less
 }
 
 void AppBreakout_Stop() {
     game_active = false;
     game_started = false;
     game_over_time = 0;
+    PanelFx_Stop();
+    Display_SetTransport(DISPLAY_RGB565);
     
     lv_obj_add_flag(paddle, LV_OBJ_FLAG_HIDDEN);
     lv_obj_add_flag(ball, LV_OBJ_FLAG_HIDDEN);
@@ -244,6 +230,8 @@ void AppBreakout_GameOver() {
     
     lv_label_set_text_fmt(status_label, "GAME OVER!\nScore: %d\n\n" LV_SYMBOL_PLAY " Restart\n" LV_SYMBOL_LEFT LV_SYMBOL_RIGHT " Navigate", score);
     lv_obj_clear_flag(status_label, LV_OBJ_FLAG_HIDDEN);
+    PanelFx_Flash(3, 120); // Panel invert flash, no redraw
+    Display_SetTransport(DISPLAY_RGB565);
 }
 
 void AppBreakout_Win() {
@@ -252,6 +240,7 @@ void AppBreakout_Win() {
     
     lv_label_set_text_fmt(status_label, "YOU WIN!\nScore: %d\n\n" LV_SYMBOL_PLAY " Restart\n" LV_SYMBOL_LEFT LV_SYMBOL_RIGHT " Navigate", score);
     lv_obj_clear_flag(status_label, LV_OBJ_FLAG_HIDDEN);
+    Display_SetTransport(DISPLAY_RGB565);
 }
 
 void AppBreakout_Update() {
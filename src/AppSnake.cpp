@@ -1,13 +1,17 @@
 #include <Arduino.h>
 #include "AppSnake.h"
-
-// Game constants - OPTIMIZED FOR RECTANGULAR FULL SCREEN
-#define GRID_WIDTH 10        // 10 cells wide
-#define GRID_HEIGHT 16       // 16 cells tall (rectangular)
-#define CELL_SIZE 11         // 11 pixels per cell
-#define GRID_OFFSET_X 12     // Center horizontally (135 - 110) / 2
-#define GRID_OFFSET_Y 55     // Start below header
-#define MAX_SNAKE_LENGTH 160 // 10x16 = 160 max
+#include "PanelFx.h"
+#include "Display.h"
+#include "Theme.h"
+
+// Game constants - 10 columns on every panel, cells and rows follow the display size
+#define HEADER_HEIGHT 50
+#define GRID_WIDTH 10                                                   // 10 cells wide
+#define CELL_SIZE ((DISPLAY_WIDTH - 20) / GRID_WIDTH)                   // 11 px on 135, 22 px on 240
+#define GRID_OFFSET_X ((DISPLAY_WIDTH - GRID_WIDTH * CELL_SIZE) / 2)    // Center horizontally
+#define GRID_OFFSET_Y (HEADER_HEIGHT + 5)                               // Start below header
+#define GRID_HEIGHT ((DISPLAY_HEIGHT - GRID_OFFSET_Y - 6) / CELL_SIZE) // 16 rows on 240 px
+#define MAX_SNAKE_LENGTH (GRID_WIDTH * GRID_HEIGHT)                     // 10x16 = 160 on 135x240
 
 // Direction constants
 #define DIR_UP 0
@@ -23,6 +27,10 @@ static lv_obj_t *grid_obj;
 static lv_obj_t *snake_parts[MAX_SNAKE_LENGTH];
 static lv_obj_t *food_obj;
 
+#if WATCH_SCREEN_GEN
+#include "screen_snake.h" // From screens/snake.json
+#endif
+
 static bool game_active = false;
 static bool game_started = false;
 static int snake_length = 3;
@@ -48,73 +56,60 @@ void AppSnake_PlaceFood();
 
 void AppSnake_Init()
 {
+#if WATCH_SCREEN_GEN
+    screen_build_snake();
+#else
     snake_screen = lv_obj_create(NULL);
     lv_obj_set_style_bg_color(snake_screen, lv_color_hex(0x0a0a0a), 0); // Black background
 
     // Header container
-    lv_obj_t *header = lv_obj_create(snake_screen);
-    lv_obj_set_size(header, 135, 50);
+    lv_obj_t *header = Theme_CreateSprite(snake_screen, THEME_HEADER);
+    lv_obj_set_size(header, DISPLAY_WIDTH, HEADER_HEIGHT);
     lv_obj_set_pos(header, 0, 0);
-    lv_obj_set_style_bg_color(header, lv_color_hex(0x1a1a2e), 0);
-    lv_obj_set_style_border_width(header, 0, 0);
-    lv_obj_set_style_pad_all(header, 0, 0);
-    lv_obj_set_style_radius(header, 0, 0);
 
     // Title
     lv_obj_t *title = lv_label_create(header);
     lv_label_set_text(title, "SNAKE");
-    lv_obj_set_style_text_font(title, &lv_font_montserrat_24, 0);
+    Theme_Apply(title, THEME_TITLE);
     lv_obj_set_style_text_color(title, lv_color_hex(0x00ff41), 0);
     lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 3);
 
     // Score
     score_label = lv_label_create(header);
     lv_label_set_text(score_label, "Score: 0");
-    lv_obj_set_style_text_font(score_label, &lv_font_montserrat_14, 0);
-    lv_obj_set_style_text_color(score_label, lv_color_hex(0xFFFFFF), 0);
+    Theme_Apply(score_label, THEME_TEXT);
     lv_obj_align(score_label, LV_ALIGN_BOTTOM_MID, 0, -3);
 
     // Grid background - RECTANGULAR FULL SCREEN
     int grid_pixel_width = GRID_WIDTH * CELL_SIZE;
     int grid_pixel_height = GRID_HEIGHT * CELL_SIZE;
 
-    grid_obj = lv_obj_create(snake_screen);
+    grid_obj = Theme_CreateSprite(snake_screen, THEME_FRAME);
     lv_obj_set_size(grid_obj, grid_pixel_width + 4, grid_pixel_height + 4);
     lv_obj_set_pos(grid_obj, GRID_OFFSET_X - 2, GRID_OFFSET_Y - 2);
     lv_obj_set_style_bg_color(grid_obj, lv_color_hex(0x0f3460), 0);
     lv_obj_set_style_border_color(grid_obj, lv_color_hex(0x00ff41), 0);
-    lv_obj_set_style_border_width(grid_obj, 2, 0);
-    lv_obj_set_style_pad_all(grid_obj, 0, 0);
-    lv_obj_set_style_radius(grid_obj, 0, 0);
 
     // Status label (centered on grid)
     status_label = lv_label_create(snake_screen);
     lv_label_set_text(status_label, "Press any\narrow to Start\n\n" LV_SYMBOL_OK " Exit");
+    Theme_Apply(status_label, THEME_STATUS);
     lv_obj_set_style_text_color(status_label, lv_color_hex(0x00ff41), 0);
-    lv_obj_set_style_text_align(status_label, LV_TEXT_ALIGN_CENTER, 0);
-    lv_obj_set_style_text_font(status_label, &lv_font_montserrat_14, 0);
     lv_obj_align(status_label, LV_ALIGN_CENTER, 0, 30);
 
-    // Create snake parts
+    // Create snake parts - all 160 share one style
     for (int i = 0; i < MAX_SNAKE_LENGTH; i++)
     {
-        snake_parts[i] = lv_obj_create(snake_screen);
+        snake_parts[i] = Theme_CreateSprite(snake_screen, THEME_SNAKE_CELL);
         lv_obj_set_size(snake_parts[i], CELL_SIZE - 2, CELL_SIZE - 2);
-        lv_obj_set_style_bg_color(snake_parts[i], lv_color_hex(0x00ff41), 0);
-        lv_obj_set_style_border_width(snake_parts[i], 0, 0);
-        lv_obj_set_style_radius(snake_parts[i], 2, 0);
-        lv_obj_set_style_pad_all(snake_parts[i], 0, 0);
         lv_obj_add_flag(snake_parts[i], LV_OBJ_FLAG_HIDDEN);
     }
 
     // Create food
-    food_obj = lv_obj_create(snake_screen);
+    food_obj = Theme_CreateSprite(snake_screen, THEME_SNAKE_FOOD);
     lv_obj_set_size(food_obj, CELL_SIZE - 2, CELL_SIZE - 2);
-    lv_obj_set_style_bg_color(food_obj, lv_color_hex(0xff0000), 0);
-    lv_obj_set_style_border_width(food_obj, 0, 0);
-    lv_obj_set_style_radius(food_obj, CELL_SIZE / 2, 0);
-    lv_obj_set_style_pad_all(food_obj, 0, 0);
     lv_obj_add_flag(food_obj, LV_OBJ_FLAG_HIDDEN);
+#endif
 }
 
 void AppSnake_PlaceFood()
@@ -199,6 +194,7 @@ void AppSnake_Start()
     lv_obj_add_flag(status_label, LV_OBJ_FLAG_HIDDEN);
 
     last_move = millis();
+    Display_SetTransport(DISPLAY_RGB444); // Fast play, colour depth matters less
 }
 
 void AppSnake_Stop()
@@ -206,6 +202,8 @@ void AppSnake_Stop()
     game_active = false;
     game_started = false;
     game_over_time = 0;
+    PanelFx_Stop();
+    Display_SetTransport(DISPLAY_RGB565);
     // Hide all game objects
     for (int i = 0; i < MAX_SNAKE_LENGTH; i++)
     {
@@ -255,6 +253,8 @@ void AppSnake_GameOver()
     game_over_time = millis();
     lv_label_set_text_fmt(status_label, "GAME OVER!\nScore: %d\n\nPress Center\nto Restart\n\n" LV_SYMBOL_OK " Exit", score);
     lv_obj_clear_flag(status_label, LV_OBJ_FLAG_HIDDEN);
+    PanelFx_Flash(3, 120); // Panel invert flash, no redraw
+    Display_SetTransport(DISPLAY_RGB565);
 }
 
 void AppSnake_Update()
@@ -327,6 +327,7 @@ void AppSnake_Update()
             lv_label_set_text_fmt(status_label, "YOU WIN!\nPerfect Score!\n\n" LV_SYMBOL_OK " Exit");
             lv_obj_clear_flag(status_label, LV_OBJ_FLAG_HIDDEN);
             game_started = false;
+            Display_SetTransport(DISPLAY_RGB565);
             return;
         }
 
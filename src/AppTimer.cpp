@@ -1,11 +1,22 @@
 #include <Arduino.h>
 #include "AppTimer.h"
+#include "PanelFx.h"
+#include "Display.h"
+#include "Fonts.h"
+#include "DigitSprite.h"
+#include "Theme.h"
+
+#define PROGRESS_WIDTH (DISPLAY_WIDTH - 35) // 100 px on 135
 
 static lv_obj_t *timer_screen;
 static lv_obj_t *time_label;
 static lv_obj_t *status_label;
 static lv_obj_t *progress_bar;
 
+#if WATCH_SCREEN_GEN
+#include "screen_timer.h" // From screens/timer.json
+#endif
+
 static int set_minutes = 5;
 static uint32_t target_ms = 0;
 static uint32_t total_ms = 0;
@@ -13,15 +24,18 @@ static uint32_t remaining_ms = 0; // ← ADD THIS to track remaining time
 static bool is_running = false;
 static bool timer_finished = false;
 
-static void anim_size_cb(void *var, int32_t v)
+static void show_time(int mins, int secs)
 {
-    lv_obj_set_style_transform_zoom((lv_obj_t *)var, v, 0);
+    char buf[8];
+    snprintf(buf, sizeof(buf), "%02d:%02d", mins, secs);
+    DigitSprite_SetText(time_label, buf); // Only the digits that changed are redrawn
 }
 
-static void anim_blink_cb(void *var, int32_t v)
+static void anim_size_cb(void *var, int32_t v)
 {
-    lv_obj_set_style_bg_opa((lv_obj_t *)var, v, 0);
+    lv_obj_set_style_transform_zoom((lv_obj_t *)var, v, 0);
 }
+
 // Add callback for buzzer
 static void (*timer_alarm_callback)() = nullptr;
 
@@ -32,33 +46,37 @@ void AppTimer_SetAlarmCallback(void (*callback)())
 
 void AppTimer_Init()
 {
+#if WATCH_SCREEN_GEN
+    screen_build_timer();
+    show_time(set_minutes, 0);
+#else
     timer_screen = lv_obj_create(NULL);
     lv_obj_set_style_bg_color(timer_screen, lv_color_hex(0x000000), 0);
 
     lv_obj_t *header = lv_label_create(timer_screen);
     lv_label_set_text(header, "TIMER");
-    lv_obj_set_style_text_font(header, &lv_font_montserrat_24, 0);
+    Theme_Apply(header, THEME_TITLE);
     lv_obj_set_style_text_color(header, lv_color_hex(0x00D9FF), 0);
     lv_obj_align(header, LV_ALIGN_TOP_MID, 0, 15);
 
     progress_bar = lv_bar_create(timer_screen);
-    lv_obj_set_size(progress_bar, 100, 8);
+    lv_obj_set_size(progress_bar, PROGRESS_WIDTH, 8);
     lv_obj_align(progress_bar, LV_ALIGN_TOP_MID, 0, 50);
     lv_bar_set_value(progress_bar, 100, LV_ANIM_OFF);
     lv_obj_set_style_bg_color(progress_bar, lv_color_hex(0x333333), LV_PART_MAIN);
     lv_obj_set_style_bg_color(progress_bar, lv_color_hex(0x00D9FF), LV_PART_INDICATOR);
 
-    time_label = lv_label_create(timer_screen);
-    lv_obj_set_style_text_font(time_label, &lv_font_montserrat_48, 0);
-    lv_obj_set_style_text_color(time_label, lv_color_hex(0xFFFFFF), 0);
-    lv_label_set_text_fmt(time_label, "%02d:00", set_minutes);
+    time_label = DigitSprite_Create(timer_screen, WATCH_FONT_48, "00:00");
+    DigitSprite_SetColor(time_label, lv_color_hex(0xFFFFFF));
+    show_time(set_minutes, 0);
     lv_obj_align(time_label, LV_ALIGN_CENTER, 0, -10);
 
     status_label = lv_label_create(timer_screen);
     lv_label_set_text(status_label, LV_SYMBOL_UP LV_SYMBOL_DOWN " Set " LV_SYMBOL_PLAY " Start");
+    Theme_Apply(status_label, THEME_STATUS);
     lv_obj_set_style_text_color(status_label, lv_color_hex(0x888888), 0);
-    lv_obj_set_style_text_font(status_label, &lv_font_montserrat_14, 0);
     lv_obj_align(status_label, LV_ALIGN_BOTTOM_MID, 0, -20);
+#endif
 }
 
 void AppTimer_Adjust(int minutes)
@@ -68,8 +86,7 @@ void AppTimer_Adjust(int minutes)
 
     if (timer_finished)
     {
-        lv_obj_set_style_bg_color(timer_screen, lv_color_hex(0x000000), 0);
-        lv_obj_set_style_bg_opa(timer_screen, LV_OPA_COVER, 0);
+        PanelFx_Stop();
         timer_finished = false;
     }
 
@@ -79,8 +96,8 @@ void AppTimer_Adjust(int minutes)
     if (set_minutes > 99)
         set_minutes = 99;
 
-    lv_label_set_text_fmt(time_label, "%02d:00", set_minutes);
-    lv_obj_set_style_text_color(time_label, lv_color_hex(0xFFFFFF), 0);
+    show_time(set_minutes, 0);
+    DigitSprite_SetColor(time_label, lv_color_hex(0xFFFFFF));
     lv_bar_set_value(progress_bar, 100, LV_ANIM_OFF);
     remaining_ms = 0; // Reset remaining time
 
@@ -98,12 +115,11 @@ void AppTimer_Toggle()
 {
     if (timer_finished)
     {
-        lv_obj_set_style_bg_color(timer_screen, lv_color_hex(0x000000), 0);
-        lv_obj_set_style_bg_opa(timer_screen, LV_OPA_COVER, 0);
-        lv_obj_set_style_text_color(time_label, lv_color_hex(0xFFFFFF), 0);
+        PanelFx_Stop();
+        DigitSprite_SetColor(time_label, lv_color_hex(0xFFFFFF));
         timer_finished = false;
         remaining_ms = 0;
-        lv_label_set_text_fmt(time_label, "%02d:00", set_minutes);
+        show_time(set_minutes, 0);
         lv_bar_set_value(progress_bar, 100, LV_ANIM_OFF);
         lv_label_set_text(status_label, LV_SYMBOL_UP LV_SYMBOL_DOWN " Set " LV_SYMBOL_PLAY " Start");
         lv_obj_set_style_text_color(status_label, lv_color_hex(0x888888), 0);
@@ -127,7 +143,7 @@ void AppTimer_Toggle()
         is_running = true;
         lv_label_set_text(status_label, LV_SYMBOL_PAUSE " Stop");
         lv_obj_set_style_text_color(status_label, lv_color_hex(0x00FF88), 0);
-        lv_obj_set_style_text_color(time_label, lv_color_hex(0x00D9FF), 0);
+        DigitSprite_SetColor(time_label, lv_color_hex(0x00D9FF));
     }
     else
     {
@@ -139,7 +155,7 @@ void AppTimer_Toggle()
         is_running = false;
         lv_label_set_text(status_label, LV_SYMBOL_PLAY " Resume");
         lv_obj_set_style_text_color(status_label, lv_color_hex(0xFFAA00), 0);
-        lv_obj_set_style_text_color(time_label, lv_color_hex(0xFFAA00), 0);
+        DigitSprite_SetColor(time_label, lv_color_hex(0xFFAA00));
     }
 }
 
@@ -155,46 +171,51 @@ void AppTimer_Update()
         is_running = false;
         timer_finished = true;
         remaining_ms = 0;
-        lv_label_set_text(time_label, "00:00");
+        show_time(0, 0);
         lv_label_set_text(status_label, LV_SYMBOL_WARNING " TIME UP!");
         lv_obj_set_style_text_color(status_label, lv_color_hex(0xFF0000), 0);
-        lv_obj_set_style_text_color(time_label, lv_color_hex(0xFF0000), 0);
+        DigitSprite_SetColor(time_label, lv_color_hex(0xFF0000));
         lv_bar_set_value(progress_bar, 0, LV_ANIM_OFF);
+
+        // Flash by inverting the panel - no pixels are re-rendered or re-sent
+        PanelFx_Flash(5, 500);
+
         // TRIGGER ALARM SOUND
         if (timer_alarm_callback != nullptr)
         {
             timer_alarm_callback();
         }
 
-        lv_obj_set_style_bg_color(timer_screen, lv_color_hex(0xFF0000), 0);
-
-        lv_anim_t a;
-        lv_anim_init(&a);
-        lv_anim_set_var(&a, timer_screen);
-        lv_anim_set_values(&a, LV_OPA_0, LV_OPA_50);
-        lv_anim_set_time(&a, 500);
-        lv_anim_set_playback_time(&a, 500);
-        lv_anim_set_repeat_count(&a, 5);
-        lv_anim_set_exec_cb(&a, anim_blink_cb);
-        lv_anim_start(&a);
-
         return;
     }
 
     int mins = diff / 60000;
     int secs = (diff % 60000) / 1000;
-    lv_label_set_text_fmt(time_label, "%02d:%02d", mins, secs);
+    show_time(mins, secs);
 
     int progress = (int)((diff * 100) / total_ms);
     lv_bar_set_value(progress_bar, progress, LV_ANIM_OFF);
 
     if (diff < 10000)
     {
-        lv_obj_set_style_text_color(time_label, lv_color_hex(0xFF0000), 0);
+        DigitSprite_SetColor(time_label, lv_color_hex(0xFF0000));
         lv_obj_set_style_bg_color(progress_bar, lv_color_hex(0xFF0000), LV_PART_INDICATOR);
     }
 }
 
+bool AppTimer_IsRunning()
+{
+    return is_running;
+}
+
+long AppTimer_MsToNextTick()
+{
+    if (!is_running)
+        return -1;
+    long diff = target_ms - millis();
+    return diff <= 0 ? 0 : diff % 1000 + 1;
+}
+
 lv_obj_t *AppTimer_GetScreen()
 {
     return timer_screen;
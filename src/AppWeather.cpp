@@ -1,9 +1,17 @@
 #include "AppWeather.h"
-#include "weather_icons.h"
+#include "IconAtlas.h"
+#include "Theme.h"
+#include "Display.h"
 #include <WiFi.h>
 #include <HTTPClient.h>
 #include <ArduinoJson.h>
 
+// Icon column and row tops; 15 and 45 / 90 / 130 on 135x240
+#define WEATHER_LEFT (DISPLAY_WIDTH / 9)
+#define WEATHER_TEMP_Y (DISPLAY_HEIGHT * 3 / 16)
+#define WEATHER_WIND_Y (DISPLAY_HEIGHT * 3 / 8)
+#define WEATHER_RAIN_Y (DISPLAY_HEIGHT * 13 / 24)
+
 static lv_obj_t *weather_screen;
 static lv_obj_t *city_label;
 
@@ -20,67 +28,77 @@ static lv_obj_t *rain_val_label;
 static lv_obj_t *status_icon_obj;
 static lv_obj_t *status_desc_label;
 
+#if WATCH_SCREEN_GEN
+#include "screen_weather.h" // From screens/weather.json
+#endif
+
 void AppWeather_Init()
 {
+#if WATCH_SCREEN_GEN
+    screen_build_weather();
+#else
     weather_screen = lv_obj_create(NULL);
-    lv_obj_set_style_bg_color(weather_screen, lv_color_hex(0x000000), 0);
+    lv_obj_set_style_bg_color(weather_screen, lv_color_hex(WEATHER_ICON_BG), 0); // Opaque icons are blended onto this
 
     // 1. City Name
     city_label = lv_label_create(weather_screen);
     lv_label_set_text(city_label, "GREATER NOIDA");
-    lv_obj_set_style_text_font(city_label, &lv_font_montserrat_14, 0);
+    Theme_Apply(city_label, THEME_CAPTION);
     lv_obj_set_style_text_color(city_label, lv_palette_main(LV_PALETTE_GREY), 0);
     lv_obj_align(city_label, LV_ALIGN_TOP_MID, 0, 10);
 
     // 2. Temperature Row
-    temp_icon_obj = lv_img_create(weather_screen);
-    lv_img_set_src(temp_icon_obj, &temp);
-    lv_obj_align(temp_icon_obj, LV_ALIGN_TOP_LEFT, 15, 45);
+    temp_icon_obj = IconAtlas_Create(weather_screen, WEATHER_ICON_TEMP);
+    lv_obj_align(temp_icon_obj, LV_ALIGN_TOP_LEFT, WEATHER_LEFT, WEATHER_TEMP_Y);
 
     temp_val_label = lv_label_create(weather_screen);
-    lv_obj_set_style_text_font(temp_val_label, &lv_font_montserrat_24, 0);
+    Theme_Apply(temp_val_label, THEME_TITLE);
     lv_obj_set_style_text_color(temp_val_label, lv_color_hex(0xCCCCCC), 0);
     lv_label_set_text(temp_val_label, "--.-°C");
     lv_obj_align_to(temp_val_label, temp_icon_obj, LV_ALIGN_OUT_RIGHT_MID, 10, 0);
 
     // 3. Wind Speed Row
-    wind_icon_obj = lv_img_create(weather_screen);
-    lv_img_set_src(wind_icon_obj, &wind);
-    lv_obj_align(wind_icon_obj, LV_ALIGN_TOP_LEFT, 20, 90);
+    wind_icon_obj = IconAtlas_Create(weather_screen, WEATHER_ICON_WIND);
+    lv_obj_align(wind_icon_obj, LV_ALIGN_TOP_LEFT, WEATHER_LEFT + 5, WEATHER_WIND_Y);
 
     wind_val_label = lv_label_create(weather_screen);
     lv_label_set_text(wind_val_label, "0.0 km/h");
-    lv_obj_set_style_text_color(wind_val_label, lv_color_hex(0xCCCCCC), 0);
+    Theme_Apply(wind_val_label, THEME_CAPTION);
     lv_obj_align_to(wind_val_label, wind_icon_obj, LV_ALIGN_OUT_RIGHT_MID, 10, 0);
 
     // 4. Precipitation Row
-    rain_icon_obj = lv_img_create(weather_screen);
-    lv_img_set_src(rain_icon_obj, &rainy);
-    lv_obj_align(rain_icon_obj, LV_ALIGN_TOP_LEFT, 20, 130);
+    rain_icon_obj = IconAtlas_Create(weather_screen, WEATHER_ICON_RAINY);
+    lv_obj_align(rain_icon_obj, LV_ALIGN_TOP_LEFT, WEATHER_LEFT + 5, WEATHER_RAIN_Y);
 
     rain_val_label = lv_label_create(weather_screen);
     lv_label_set_text(rain_val_label, "Rain: 0%");
-    lv_obj_set_style_text_color(rain_val_label, lv_color_hex(0xCCCCCC), 0);
+    Theme_Apply(rain_val_label, THEME_CAPTION);
     lv_obj_align_to(rain_val_label, rain_icon_obj, LV_ALIGN_OUT_RIGHT_MID, 10, 0);
 
     // 5. Overall Weather Status (Bottom)
-    status_icon_obj = lv_img_create(weather_screen);
-    lv_img_set_src(status_icon_obj, &clear); // Default
-    lv_obj_align(status_icon_obj, LV_ALIGN_BOTTOM_LEFT, 20, -30);
+    status_icon_obj = IconAtlas_Create(weather_screen, WEATHER_ICON_CLEAR); // Default
+    lv_obj_align(status_icon_obj, LV_ALIGN_BOTTOM_LEFT, WEATHER_LEFT + 5, -30);
 
     status_desc_label = lv_label_create(weather_screen);
     lv_label_set_text(status_desc_label, "Clear Sky");
     lv_obj_set_style_text_color(status_desc_label, lv_palette_main(LV_PALETTE_AMBER), 0);
     lv_obj_align_to(status_desc_label, status_icon_obj, LV_ALIGN_OUT_RIGHT_MID, 10, 0);
+#endif
 }
 
 lv_obj_t *AppWeather_GetScreen() { return weather_screen; }
 
 void AppWeather_Update() {
     if (weather_screen == NULL || temp_val_label == NULL) return;
+    WeatherReading r;
+    if (AppWeather_Fetch(&r))
+        AppWeather_Show(&r);
+}
+
+bool AppWeather_Fetch(WeatherReading *out) {
     if (WiFi.status() != WL_CONNECTED) {
         Serial.println("WiFi not connected!");
-        return;
+        return false;
     }
 
     Serial.println("Fetching weather data...");
@@ -89,48 +107,57 @@ void AppWeather_Update() {
     
     http.begin(url);
     int httpCode = http.GET();
+    bool ok = httpCode == HTTP_CODE_OK;
 
-    if (httpCode == HTTP_CODE_OK) {
+    if (ok) {
         String payload = http.getString();
         Serial.println("Got API response");
         
         DynamicJsonDocument doc(2048); 
         deserializeJson(doc, payload);
 
-        float t = doc["current"]["temperature_2m"];
-        float w = doc["current"]["wind_speed_10m"];
-        int code = doc["current"]["weather_code"];
-        int rain_prob = doc["hourly"]["precipitation_probability"][0];
+        out->temp_c = doc["current"]["temperature_2m"];
+        out->wind_kmh = doc["current"]["wind_speed_10m"];
+        out->code = doc["current"]["weather_code"];
+        out->rain_prob = doc["hourly"]["precipitation_probability"][0];
 
-        Serial.printf("Raw data: %.1f°C, %.1f km/h, %d%% rain\n", t, w, rain_prob);
-
-        // CRITICAL FIX: Use static buffers for text
-        static char temp_buf[16];
-        static char wind_buf[16];
-        static char rain_buf[16];
-        
-        sprintf(temp_buf, "%.1f°C", t);
-        sprintf(wind_buf, "%.1f km/h", w);
-        sprintf(rain_buf, "Rain: %d%%", rain_prob);
-        
-        lv_label_set_text(temp_val_label, temp_buf);
-        lv_label_set_text(wind_val_label, wind_buf);
-        lv_label_set_text(rain_val_label, rain_buf);
-
-        if (code == 0) lv_label_set_text(status_desc_label, "Clear Sky");
-        else if (code <= 3) lv_label_set_text(status_desc_label, "Cloudy");
-        else if (code >= 95) lv_label_set_text(status_desc_label, "Stormy");
-        else lv_label_set_text(status_desc_label, "Rainy");
-
-        // Force refresh
-        lv_obj_invalidate(temp_val_label);
-        lv_obj_invalidate(wind_val_label);
-        lv_obj_invalidate(rain_val_label);
-        lv_obj_invalidate(status_desc_label);
-        
-        Serial.println("Labels updated!");
+        Serial.printf("Raw data: %.1f°C, %.1f km/h, %d%% rain\n", out->temp_c, out->wind_kmh, out->rain_prob);
     } else {
         Serial.printf("HTTP Error: %d\n", httpCode);
     }
     http.end();
-}
\ No newline at end of file
+    return ok;
+}
+
+void AppWeather_Show(const WeatherReading *r) {
+    if (weather_screen == NULL || temp_val_label == NULL) return;
+
+    // CRITICAL FIX: Use static buffers for text
+    static char temp_buf[16];
+    static char wind_buf[16];
+    static char rain_buf[16];
+    
+    sprintf(temp_buf, "%.1f°C", r->temp_c);
+    sprintf(wind_buf, "%.1f km/h", r->wind_kmh);
+    sprintf(rain_buf, "Rain: %d%%", r->rain_prob);
+    
+    lv_label_set_text(temp_val_label, temp_buf);
+    lv_label_set_text(wind_val_label, wind_buf);
+    lv_label_set_text(rain_val_label, rain_buf);
+
+    int code = r->code;
+    WeatherIcon status;
+    if (code == 0) { lv_label_set_text(status_desc_label, "Clear Sky"); status = WEATHER_ICON_CLEAR; }
+    else if (code <= 3) { lv_label_set_text(status_desc_label, "Cloudy"); status = WEATHER_ICON_CLOUDY; }
+    else if (code >= 95) { lv_label_set_text(status_desc_label, "Stormy"); status = WEATHER_ICON_STORMY; }
+    else { lv_label_set_text(status_desc_label, "Rainy"); status = WEATHER_ICON_RAINY; }
+    IconAtlas_Set(status_icon_obj, status);
+
+    // Force refresh
+    lv_obj_invalidate(temp_val_label);
+    lv_obj_invalidate(wind_val_label);
+    lv_obj_invalidate(rain_val_label);
+    lv_obj_invalidate(status_desc_label);
+    
+    Serial.println("Labels updated!");
+}
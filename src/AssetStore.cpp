@@ -0,0 +1,185 @@
+#include "AssetStore.h"
+#include <string.h>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#include <esp_partition.h>
+#include <esp32/rom/crc.h>
+#define ASSET_LOG(...) Serial.printf(__VA_ARGS__)
+#else
+// Host build: a file stands in for the partition (e.g. .pio/build/<env>/generated/assets.bin)
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ASSET_LOG(...) printf(__VA_ARGS__)
+#endif
+
+// Container written by tools/asset_pack.py
+#define ASSET_SUBTYPE 0x41
+#define ASSET_MAGIC 0x54534157 // "WAST"
+#define ASSET_VERSION 1
+#define ASSET_NAME_LEN 16
+
+struct AssetHeader
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t count;
+    uint32_t total;
+    uint32_t crc; // CRC-32 of bytes sizeof(AssetHeader)..total
+};
+
+struct AssetEntry
+{
+    char name[ASSET_NAME_LEN];
+    uint32_t offset;
+    uint32_t size;
+    uint8_t cf;
+    uint8_t reserved;
+    uint16_t w;
+    uint16_t h;
+    uint16_t reserved2;
+};
+
+static_assert(sizeof(AssetHeader) == 16 && sizeof(AssetEntry) == 32, "must match tools/asset_pack.py");
+
+static lv_img_dsc_t images[ASSET_STORE_MAX];
+static char names[ASSET_STORE_MAX][ASSET_NAME_LEN];
+static int count = 0;
+static bool mounted = false;
+static bool mount_failed = false; // Tried once: a missing or corrupt pack is not re-read on every lookup
+
+// --- Mapping ---
+#ifdef ARDUINO
+static spi_flash_mmap_handle_t map_handle;
+
+static const uint8_t *map_store(uint32_t *size)
+{
+    const esp_partition_t *part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                                           (esp_partition_subtype_t)ASSET_SUBTYPE, "assets");
+    if (!part)
+        return NULL;
+    // Kept mapped for good: LVGL reads the images through the flash cache whenever it draws
+    const void *map;
+    if (esp_partition_mmap(part, 0, part->size, SPI_FLASH_MMAP_DATA, &map, &map_handle) != ESP_OK)
+        return NULL;
+    *size = part->size;
+    return (const uint8_t *)map;
+}
+
+static void unmap_store(const uint8_t *base, uint32_t size)
+{
+    spi_flash_munmap(map_handle);
+}
+
+static uint32_t store_crc(const uint8_t *data, uint32_t len)
+{
+    return crc32_le(0, data, len);
+}
+#else
+static const uint8_t *map_store(uint32_t *size)
+{
+    const char *path = getenv("ASSET_STORE_FILE");
+    int fd = open(path ? path : "assets.bin", O_RDONLY);
+    if (fd < 0)
+        return NULL;
+    struct stat st;
+    void *map = fstat(fd, &st) == 0 ? mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+    close(fd);
+    if (map == MAP_FAILED)
+        return NULL;
+    *size = st.st_size;
+    return (const uint8_t *)map;
+}
+
+static void unmap_store(const uint8_t *base, uint32_t size)
+{
+    munmap((void *)base, size);
+}
+
+static uint32_t store_crc(const uint8_t *data, uint32_t len)
+{
+    uint32_t crc = 0xFFFFFFFF;
+    while (len--)
+    {
+        crc ^= *data++;
+        for (int i = 0; i < 8; i++)
+            crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+    }
+    return ~crc;
+}
+#endif
+
+// --- API ---
+bool AssetStore_Mount()
+{
+    if (mounted || mount_failed)
+        return mounted;
+
+    uint32_t size = 0;
+    const uint8_t *base = map_store(&size);
+    mount_failed = true; // Until the checks below pass
+    if (!base)
+    {
+        ASSET_LOG("AssetStore: no assets partition\n");
+        return false;
+    }
+
+    // An erased or half-written partition fails here rather than drawing garbage
+    const AssetHeader *header = (const AssetHeader *)base;
+    if (size < sizeof(AssetHeader) || header->magic != ASSET_MAGIC || header->version != ASSET_VERSION ||
+        header->total > size || header->count > ASSET_STORE_MAX ||
+        sizeof(AssetHeader) + header->count * sizeof(AssetEntry) > header->total)
+    {
+        ASSET_LOG("AssetStore: no valid pack (flash it with `pio run -t upload_assets`)\n");
+        unmap_store(base, size);
+        return false;
+    }
+    if (store_crc(base + sizeof(AssetHeader), header->total - sizeof(AssetHeader)) != header->crc)
+    {
+        ASSET_LOG("AssetStore: CRC mismatch\n");
+        unmap_store(base, size);
+        return false;
+    }
+
+    const AssetEntry *entries = (const AssetEntry *)(base + sizeof(AssetHeader));
+    for (int i = 0; i < header->count; i++)
+    {
+        const AssetEntry *e = &entries[i];
+        if (e->offset + e->size > header->total || e->name[ASSET_NAME_LEN - 1])
+            continue;
+        lv_img_dsc_t *img = &images[count];
+        img->header.always_zero = 0;
+        img->header.cf = e->cf;
+        img->header.w = e->w;
+        img->header.h = e->h;
+        img->data_size = e->size;
+        img->data = base + e->offset;
+        memcpy(names[count], e->name, ASSET_NAME_LEN);
+        count++;
+    }
+    mounted = true;
+    mount_failed = false;
+    ASSET_LOG("AssetStore: %d assets, %lu bytes\n", count, (unsigned long)header->total);
+    return true;
+}
+
+const lv_img_dsc_t *AssetStore_Image(const char *name)
+{
+    for (int i = 0; i < count; i++)
+        if (strcmp(names[i], name) == 0)
+            return &images[i];
+    return NULL;
+}
+
+const lv_img_dsc_t *AssetStore_At(int index, const char **name)
+{
+    if (index < 0 || index >= count)
+        return NULL;
+    if (name)
+        *name = names[index];
+    return &images[index];
+}
@@ -0,0 +1,482 @@
+#include <Arduino.h>
+#include "Background.h"
+#include "Display.h"
+#include "AssetStore.h"
+
+#define BG_W DISPLAY_WIDTH // The pipeline renders the photo at the panel size
+#define BG_H DISPLAY_HEIGHT
+
+// Formats that end up in the image; the benchmark compares all of them against raw
+#define BG_LINKED(format) (WATCH_BG_FORMAT == (format) || DISPLAY_BENCH)
+
+// An unreferenced const array never reaches flash, but the indexed-8 header is only
+// generated when it is used (see tools/asset_pipeline.py). With WATCH_ASSET_STORE the
+// same bytes come from the assets partition instead.
+#if !WATCH_ASSET_STORE
+#include "bg_image.h"
+#include "bg_image_q565.h"
+#if BG_LINKED(BG_FORMAT_INDEXED8)
+#include "bg_image_i8.h"
+#endif
+#endif
+
+static int shown_format = WATCH_BG_FORMAT;
+static const lv_img_dsc_t *face_img = NULL; // Watch face decoded into RAM (WatchFace.cpp), NULL = photo
+static lv_obj_t *bg_img = NULL;
+
+static inline uint16_t to_lvgl(uint16_t px)
+{
+#if LV_COLOR_16_SWAP
+    return (px >> 8) | (px << 8);
+#else
+    return px;
+#endif
+}
+
+// --- Image Data ---
+// Descriptors are bound in Background_Init: to the compiled-in arrays, or zero-copy to
+// the mapped assets partition. data stays NULL if an image is missing from the store.
+#if BG_LINKED(BG_FORMAT_Q565)
+static lv_img_dsc_t bg_q565 = {{LV_IMG_CF_USER_ENCODED_0, 0, 0, BG_W, BG_H}, 0, NULL};
+#endif
+#if BG_LINKED(BG_FORMAT_INDEXED8)
+// Same bytes the built-in decoder understands; ours claims it first and skips its alpha path
+static lv_img_dsc_t bg_i8 = {{LV_IMG_CF_INDEXED_8BIT, 0, 0, BG_W, BG_H}, 0, NULL};
+#endif
+#if BG_LINKED(BG_FORMAT_RAW)
+static lv_img_dsc_t bg_raw = {{LV_IMG_CF_TRUE_COLOR, 0, 0, BG_W, BG_H}, 0, NULL};
+#endif
+
+#if WATCH_ASSET_STORE
+#define BG_BIND(dsc, name, array) bg_bind(&dsc, name)
+
+static void bg_bind(lv_img_dsc_t *dsc, const char *name)
+{
+    const lv_img_dsc_t *asset = AssetStore_Mount() ? AssetStore_Image(name) : NULL;
+    if (!asset || asset->header.cf != dsc->header.cf || asset->header.w != BG_W || asset->header.h != BG_H)
+    {
+        Serial.printf("Background: %s not in the asset store\n", name);
+        return;
+    }
+    dsc->data = asset->data;
+    dsc->data_size = asset->data_size;
+}
+#else
+#define BG_BIND(dsc, name, array) (dsc.data = (const uint8_t *)(array), dsc.data_size = sizeof(array))
+#endif
+
+#if BG_LINKED(BG_FORMAT_Q565)
+// --- Q565 Decoder ---
+// Format and encoder: tools/asset_pipeline.py. Each row starts from a black previous
+// pixel and an empty index, so any row can be decoded on its own via the offset table.
+#define Q565_TABLE 8 // Offset of the u32 row offset table
+#define Q565_OP_INDEX 0x00
+#define Q565_OP_DIFF 0x40
+#define Q565_OP_LUMA 0x80
+#define Q565_OP_RUN 0xC0
+#define Q565_OP_RGB 0xFE
+#define Q565_OP_MASK 0xC0
+#define Q565_HASH(p) ((((p) >> 11) * 3 + (((p) >> 5) & 0x3F) * 5 + ((p) & 0x1F) * 7) & 63)
+
+static inline uint32_t rd16(const uint8_t *p) { return p[0] | (p[1] << 8); }
+static inline uint32_t rd32(const uint8_t *p) { return rd16(p) | (rd16(p + 2) << 16); }
+
+static uint32_t q565_row_offset(const uint8_t *blob, int y)
+{
+    return rd32(blob + Q565_TABLE + y * 4);
+}
+
+// Expand one full row into out (LVGL byte order)
+static void IRAM_ATTR q565_decode_row(const uint8_t *blob, int y, uint16_t *out)
+{
+    const int w = rd16(blob + 4);
+    const uint8_t *s = blob + q565_row_offset(blob, y);
+    uint16_t index[64];
+    memset(index, 0, sizeof(index));
+    uint32_t px = 0;
+    int x = 0;
+
+    while (x < w)
+    {
+        uint32_t op = *s++;
+        if (op == Q565_OP_RGB)
+        {
+            px = (s[0] << 8) | s[1];
+            s += 2;
+        }
+        else
+        {
+            switch (op & Q565_OP_MASK)
+            {
+            case Q565_OP_INDEX:
+                px = index[op];
+                out[x++] = to_lvgl(px);
+                continue; // Already in the index
+            case Q565_OP_DIFF:
+            {
+                uint32_t r = ((px >> 11) + ((op >> 4) & 3) - 2) & 0x1F;
+                uint32_t g = (((px >> 5) & 0x3F) + ((op >> 2) & 3) - 2) & 0x3F;
+                uint32_t b = ((px & 0x1F) + (op & 3) - 2) & 0x1F;
+                px = (r << 11) | (g << 5) | b;
+                break;
+            }
+            case Q565_OP_LUMA:
+            {
+                int dg = (int)(op & 0x3F) - 32;
+                int rb = *s++;
+                int dr = (rb >> 4) - 8 + (dg >> 1);
+                int db = (rb & 0x0F) - 8 + (dg >> 1);
+                uint32_t r = ((px >> 11) + dr) & 0x1F;
+                uint32_t g = (((px >> 5) & 0x3F) + dg) & 0x3F;
+                uint32_t b = ((px & 0x1F) + db) & 0x1F;
+                px = (r << 11) | (g << 5) | b;
+                break;
+            }
+            default: // Q565_OP_RUN
+            {
+                int run = (op & 0x3F) + 1;
+                uint16_t v = to_lvgl(px);
+                while (run-- && x < w)
+                    out[x++] = v;
+                continue;
+            }
+            }
+        }
+        index[Q565_HASH(px)] = px;
+        out[x++] = to_lvgl(px);
+    }
+}
+
+// Last decoded row: LVGL asks for each row once per draw, but neighbouring areas share rows
+static uint16_t row_cache[BG_W];
+static int row_cache_y = -1;
+
+static const uint16_t *q565_row(int y)
+{
+    if (y != row_cache_y)
+    {
+        q565_decode_row(bg_q565.data, y, row_cache);
+        row_cache_y = y;
+    }
+    return row_cache;
+}
+
+#endif
+
+#if BG_LINKED(BG_FORMAT_INDEXED8)
+// --- Indexed-8 Lookup ---
+// LVGL layout: 256 lv_color32_t palette entries, then one index byte per pixel
+#define I8_PALETTE_BYTES (256 * sizeof(lv_color32_t))
+
+static lv_color_t i8_palette[256]; // Palette converted once to RGB565 in LVGL byte order
+
+static void i8_init()
+{
+    const lv_color32_t *pal = (const lv_color32_t *)bg_i8.data;
+    for (int i = 0; i < 256; i++)
+        i8_palette[i] = lv_color_make(pal[i].ch.red, pal[i].ch.green, pal[i].ch.blue);
+}
+
+static void IRAM_ATTR i8_read_row(int y, int x, int len, lv_color_t *out)
+{
+    const uint8_t *idx = bg_i8.data + I8_PALETTE_BYTES + y * BG_W + x;
+    for (int i = 0; i < len; i++)
+        out[i] = i8_palette[idx[i]];
+}
+#endif
+
+// Pixels x..x+len-1 of row y in any linked format
+static void bg_read_row(int format, int y, int x, int len, lv_color_t *out)
+{
+    if (!Background_Image(format))
+    {
+        memset(out, 0, len * sizeof(lv_color_t));
+        return;
+    }
+    switch (format)
+    {
+#if BG_LINKED(BG_FORMAT_Q565)
+    case BG_FORMAT_Q565:
+        memcpy(out, q565_row(y) + x, len * sizeof(lv_color_t));
+        break;
+#endif
+#if BG_LINKED(BG_FORMAT_INDEXED8)
+    case BG_FORMAT_INDEXED8:
+        i8_read_row(y, x, len, out);
+        break;
+#endif
+#if BG_LINKED(BG_FORMAT_RAW)
+    case BG_FORMAT_RAW:
+        memcpy(out, (const lv_color_t *)bg_raw.data + y * BG_W + x, len * sizeof(lv_color_t));
+        break;
+#endif
+    default:
+        break;
+    }
+}
+
+#if BG_LINKED(BG_FORMAT_Q565) || BG_LINKED(BG_FORMAT_INDEXED8)
+// --- LVGL Image Decoder ---
+// Claims the compressed and indexed backgrounds and reports them as opaque true colour,
+// so lv_img still covers the screen. open_cb leaves img_data NULL: LVGL then draws line
+// by line and only the rows of the current stripe are expanded.
+static int bg_format_of(const void *src)
+{
+    if (lv_img_src_get_type(src) != LV_IMG_SRC_VARIABLE)
+        return -1;
+#if BG_LINKED(BG_FORMAT_Q565)
+    if (src == &bg_q565)
+        return BG_FORMAT_Q565;
+#endif
+#if BG_LINKED(BG_FORMAT_INDEXED8)
+    if (src == &bg_i8)
+        return BG_FORMAT_INDEXED8;
+#endif
+    return -1;
+}
+
+static lv_res_t bg_info(lv_img_decoder_t *decoder, const void *src, lv_img_header_t *header)
+{
+    LV_UNUSED(decoder);
+    if (bg_format_of(src) < 0)
+        return LV_RES_INV;
+    header->cf = LV_IMG_CF_TRUE_COLOR;
+    header->always_zero = 0;
+    header->w = BG_W;
+    header->h = BG_H;
+    return LV_RES_OK;
+}
+
+static lv_res_t bg_open(lv_img_decoder_t *decoder, lv_img_decoder_dsc_t *dsc)
+{
+    LV_UNUSED(decoder);
+    dsc->img_data = NULL; // Line by line via bg_read_line
+    return LV_RES_OK;
+}
+
+static lv_res_t bg_read_line(lv_img_decoder_t *decoder, lv_img_decoder_dsc_t *dsc,
+                             lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t *buf)
+{
+    LV_UNUSED(decoder);
+    bg_read_row(bg_format_of(dsc->src), y, x, len, (lv_color_t *)buf);
+    return LV_RES_OK;
+}
+#endif
+
+// --- Public API ---
+void Background_Init()
+{
+#if BG_LINKED(BG_FORMAT_RAW)
+    BG_BIND(bg_raw, "bg_raw", my_image_map);
+#endif
+#if BG_LINKED(BG_FORMAT_Q565)
+    BG_BIND(bg_q565, "bg_q565", bg_image_q565);
+#endif
+#if BG_LINKED(BG_FORMAT_INDEXED8)
+    BG_BIND(bg_i8, "bg_i8", bg_image_i8);
+    if (bg_i8.data)
+        i8_init();
+#endif
+#if BG_LINKED(BG_FORMAT_Q565) || BG_LINKED(BG_FORMAT_INDEXED8)
+    lv_img_decoder_t *decoder = lv_img_decoder_create();
+    lv_img_decoder_set_info_cb(decoder, bg_info);
+    lv_img_decoder_set_open_cb(decoder, bg_open);
+    lv_img_decoder_set_read_line_cb(decoder, bg_read_line);
+#endif
+}
+
+const lv_img_dsc_t *Background_Image(int format)
+{
+    const lv_img_dsc_t *img = NULL;
+    switch (format)
+    {
+#if BG_LINKED(BG_FORMAT_RAW)
+    case BG_FORMAT_RAW:
+        img = &bg_raw;
+        break;
+#endif
+#if BG_LINKED(BG_FORMAT_Q565)
+    case BG_FORMAT_Q565:
+        img = &bg_q565;
+        break;
+#endif
+#if BG_LINKED(BG_FORMAT_INDEXED8)
+    case BG_FORMAT_INDEXED8:
+        img = &bg_i8;
+        break;
+#endif
+    default:
+        break;
+    }
+    return img && img->data ? img : NULL;
+}
+
+lv_obj_t *Background_Create(lv_obj_t *parent, int format)
+{
+    if (!Background_Image(format))
+        format = WATCH_BG_FORMAT;
+    shown_format = format;
+    bg_img = lv_img_create(parent);
+    lv_img_set_src(bg_img, face_img ? face_img : Background_Image(format));
+    return bg_img;
+}
+
+void Background_SetFace(const lv_img_dsc_t *face)
+{
+    face_img = face;
+    if (!bg_img)
+        return;
+    if (face)
+        lv_img_cache_invalidate_src(face); // Same descriptor, new pixels
+    lv_img_set_src(bg_img, face ? face : Background_Image(shown_format));
+}
+
+void Background_ReadRow(int y, int x, int len, lv_color_t *out)
+{
+    if (face_img)
+        memcpy(out, (const lv_color_t *)face_img->data + y * BG_W + x, len * sizeof(lv_color_t));
+    else
+        bg_read_row(shown_format, y, x, len, out);
+}
+
+// --- Benchmark ---
+#if DISPLAY_BENCH
+#define BENCH_PASSES 10
+#define BENCH_FRAMES 5
+
+static const char *const format_names[BG_FORMAT_COUNT] = {"raw", "q565", "i8"};
+
+// Full frame, one draw stripe at a time into a RAM stripe buffer, like the renderer
+static uint32_t bench_sweep(int format, lv_color_t *stripe)
+{
+    uint32_t t0 = micros();
+    for (int y = 0; y < BG_H; y++)
+    {
+        lv_color_t *row = stripe + (y % DISPLAY_BUF_LINES) * BG_W;
+        if (format == BG_FORMAT_Q565)
+            q565_decode_row(bg_q565.data, y, (uint16_t *)row); // Bypass the row cache
+        else
+            bg_read_row(format, y, 0, BG_W, row);
+    }
+    return micros() - t0;
+}
+
+// Most flash bytes a single draw stripe pulls through the cache
+static unsigned long bench_stripe_bytes(int format)
+{
+    if (format == BG_FORMAT_INDEXED8)
+        return BG_W * DISPLAY_BUF_LINES + 256 * sizeof(lv_color32_t);
+    if (format == BG_FORMAT_Q565)
+    {
+        unsigned long most = 0;
+        for (int y = 0; y < BG_H; y += DISPLAY_BUF_LINES)
+        {
+            int y2 = min(y + DISPLAY_BUF_LINES, BG_H);
+            most = max(most, (unsigned long)(q565_row_offset(bg_q565.data, y2) - q565_row_offset(bg_q565.data, y)));
+        }
+        return most;
+    }
+    return BG_W * DISPLAY_BUF_LINES * 2;
+}
+
+// RGB565 to 8-bit channels, expanded the way the asset pipeline measures its error
+static void bench_rgb888(uint32_t px, int *c)
+{
+    c[0] = ((px >> 11) << 3) | (px >> 13);
+    c[1] = (((px >> 5) & 0x3F) << 2) | ((px >> 9) & 0x03);
+    c[2] = ((px & 0x1F) << 3) | ((px >> 2) & 0x07);
+}
+
+// PSNR against the raw array; 0 = identical
+static float bench_psnr(int format, lv_color_t *row, unsigned long *max_err)
+{
+    uint64_t sse = 0;
+    *max_err = 0;
+    for (int y = 0; y < BG_H; y++)
+    {
+        bg_read_row(format, y, 0, BG_W, row);
+        for (int x = 0; x < BG_W; x++)
+        {
+            int a[3], b[3];
+            bench_rgb888(to_lvgl(row[x].full), a); // Back to plain RGB565: a swap is its own inverse
+            bench_rgb888(to_lvgl(((const uint16_t *)bg_raw.data)[y * BG_W + x]), b);
+            for (int c = 0; c < 3; c++)
+            {
+                int d = a[c] - b[c];
+                sse += d * d;
+                *max_err = max(*max_err, (unsigned long)abs(d));
+            }
+        }
+    }
+    if (!sse)
+        return 0;
+    return 10.0f * log10f(255.0f * 255.0f * BG_W * BG_H * 3 / (float)sse);
+}
+
+// Full-screen redraw (render + flush) with the background in format. The flush part is
+// the same for every format, so the differences are decode cost.
+static uint32_t bench_frame(int format)
+{
+    lv_img_set_src(bg_img, Background_Image(format));
+    uint32_t total_us = 0;
+    for (int i = 0; i < BENCH_FRAMES; i++)
+    {
+        Display_WaitIdle();
+        lv_obj_invalidate(lv_scr_act());
+        uint32_t t0 = micros();
+        lv_refr_now(NULL);
+        Display_WaitIdle();
+        total_us += micros() - t0;
+    }
+    return total_us / BENCH_FRAMES;
+}
+#endif
+
+void Background_RunBenchmark()
+{
+#if DISPLAY_BENCH
+    if (!Background_Image(BG_FORMAT_RAW))
+    {
+        Serial.println("[bench] bg: no raw reference image");
+        return;
+    }
+    lv_color_t *stripe = (lv_color_t *)malloc(BG_W * DISPLAY_BUF_LINES * sizeof(lv_color_t));
+    if (!stripe)
+    {
+        Serial.println("[bench] bg: out of memory");
+        return;
+    }
+
+    for (int f = 0; f < BG_FORMAT_COUNT; f++)
+    {
+        const lv_img_dsc_t *img = Background_Image(f);
+        if (!img)
+            continue;
+
+        // The first sweep after the previous format runs against a cold flash cache
+        uint32_t first_us = bench_sweep(f, stripe);
+        uint32_t total_us = 0;
+        for (int i = 0; i < BENCH_PASSES; i++)
+            total_us += bench_sweep(f, stripe);
+        uint32_t avg_us = total_us / BENCH_PASSES;
+
+        unsigned long max_err;
+        float psnr = bench_psnr(f, stripe, &max_err);
+        uint32_t frame_us = bg_img ? bench_frame(f) : 0;
+
+        char quality[32];
+        if (psnr > 0)
+            snprintf(quality, sizeof(quality), "PSNR %5.2f dB max %3lu", psnr, max_err);
+        else
+            snprintf(quality, sizeof(quality), "lossless");
+        Serial.printf("[bench] bg %-4s %5lu B flash, stripe %5lu B  read first %5lu avg %5lu us  frame %6lu us  %s%s\n",
+                      format_names[f], (unsigned long)img->data_size, bench_stripe_bytes(f),
+                      (unsigned long)first_us, (unsigned long)avg_us, (unsigned long)frame_us, quality,
+                      f == shown_format ? " (shown)" : "");
+    }
+
+    if (bg_img)
+        lv_img_set_src(bg_img, face_img ? face_img : Background_Image(shown_format));
+    free(stripe);
+#endif
+}
@@ -0,0 +1,342 @@
+#include <Arduino.h>
+#include "DigitSprite.h"
+#include "Display.h"
+#include "Fonts.h"
+
+#define DIGIT_GLYPHS 11 // '0'-'9', ':'
+#define COLON_GLYPH 10
+
+// A8 cells of one font, line_height tall, rendered the way lv_draw_letter places glyphs
+struct DigitFont
+{
+    const lv_font_t *font;
+    uint8_t digit_w; // Widest digit advance: every digit cell has this width
+    uint8_t colon_w;
+    uint8_t h;
+    uint8_t *pixels;
+    lv_img_dsc_t cells[DIGIT_GLYPHS];
+};
+
+struct DigitText
+{
+    lv_obj_t *obj;
+    DigitFont *font;
+    char text[DIGIT_SPRITE_MAX_CELLS + 1];
+    lv_obj_t *cells[DIGIT_SPRITE_MAX_CELLS];
+    lv_color_t color;
+};
+
+static DigitFont fonts[DIGIT_SPRITE_MAX_FONTS];
+static DigitText texts[DIGIT_SPRITE_MAX_TEXTS];
+
+static int glyph_index(char c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    return c == ':' ? COLON_GLYPH : -1;
+}
+
+static void render_glyph(const lv_font_t *font, uint32_t letter, uint8_t *cell, int cell_w, int cell_h)
+{
+    lv_font_glyph_dsc_t g;
+    if (!lv_font_get_glyph_dsc(font, &g, letter, 0))
+        return;
+    const uint8_t *bitmap = lv_font_get_glyph_bitmap(font, letter);
+    if (!bitmap)
+        return;
+
+    // Centred in the cell; vertical position as in lv_draw_letter
+    int x0 = (cell_w - g.adv_w) / 2 + g.ofs_x;
+    int y0 = (font->line_height - font->base_line) - g.box_h - g.ofs_y;
+    uint32_t max = (1u << g.bpp) - 1;
+    uint32_t bit = 0;
+    for (int y = 0; y < g.box_h; y++)
+    {
+        for (int x = 0; x < g.box_w; x++, bit += g.bpp)
+        {
+            // Glyph pixels are packed MSB first, continuously across rows
+            uint32_t v = (bitmap[bit >> 3] >> (8 - g.bpp - (bit & 7))) & max;
+            int cx = x0 + x, cy = y0 + y;
+            if (v && cx >= 0 && cx < cell_w && cy >= 0 && cy < cell_h)
+                cell[cy * cell_w + cx] = v * 255 / max;
+        }
+    }
+}
+
+static DigitFont *get_font(const lv_font_t *font)
+{
+    DigitFont *f = NULL;
+    for (int i = 0; i < DIGIT_SPRITE_MAX_FONTS; i++)
+    {
+        if (fonts[i].font == font)
+            return &fonts[i];
+        if (!f && !fonts[i].font)
+            f = &fonts[i];
+    }
+    if (!f)
+        return NULL;
+
+    lv_font_glyph_dsc_t g;
+    int digit_w = 0;
+    for (char c = '0'; c <= '9'; c++)
+        if (lv_font_get_glyph_dsc(font, &g, c, 0) && g.adv_w > digit_w)
+            digit_w = g.adv_w;
+    int colon_w = lv_font_get_glyph_dsc(font, &g, ':', 0) ? g.adv_w : digit_w / 2;
+    int h = lv_font_get_line_height(font);
+
+    size_t bytes = (size_t)(10 * digit_w + colon_w) * h;
+    uint8_t *pixels = (uint8_t *)malloc(bytes);
+    if (!pixels)
+    {
+        Serial.println("DigitSprite: out of memory");
+        return NULL;
+    }
+    memset(pixels, 0, bytes);
+
+    f->font = font;
+    f->digit_w = digit_w;
+    f->colon_w = colon_w;
+    f->h = h;
+    f->pixels = pixels;
+    uint8_t *p = pixels;
+    for (int i = 0; i < DIGIT_GLYPHS; i++)
+    {
+        int w = i == COLON_GLYPH ? colon_w : digit_w;
+        render_glyph(font, i == COLON_GLYPH ? ':' : '0' + i, p, w, h);
+
+        lv_img_dsc_t *cell = &f->cells[i];
+        cell->header.always_zero = 0;
+        cell->header.cf = LV_IMG_CF_ALPHA_8BIT; // Drawn in the img_recolor colour
+        cell->header.w = w;
+        cell->header.h = h;
+        cell->data_size = w * h;
+        cell->data = p;
+        p += w * h;
+    }
+    return f;
+}
+
+// --- Sprite text ---
+
+static void sprite_delete_cb(lv_event_t *e)
+{
+    DigitText *t = (DigitText *)lv_event_get_user_data(e);
+    t->obj = NULL;
+}
+
+static DigitText *sprite_of(lv_obj_t *obj)
+{
+    for (int i = 0; i < DIGIT_SPRITE_MAX_TEXTS; i++)
+        if (texts[i].obj == obj)
+            return &texts[i];
+    return NULL;
+}
+
+// One image per character; rebuilt only when the layout (length or ':' positions) changes
+static void sprite_layout(DigitText *t, const char *text)
+{
+    lv_obj_clean(t->obj);
+    int n = strlen(text);
+    if (n > DIGIT_SPRITE_MAX_CELLS)
+        n = DIGIT_SPRITE_MAX_CELLS;
+
+    int x = 0;
+    for (int i = 0; i < n; i++)
+    {
+        int glyph = glyph_index(text[i]);
+        lv_obj_t *cell = lv_img_create(t->obj);
+        lv_obj_set_pos(cell, x, 0);
+        if (glyph >= 0)
+            lv_img_set_src(cell, &t->font->cells[glyph]);
+        lv_obj_set_size(cell, glyph == COLON_GLYPH ? t->font->colon_w : t->font->digit_w, t->font->h);
+        lv_obj_set_style_img_recolor(cell, t->color, 0);
+        t->cells[i] = cell;
+        t->text[i] = text[i];
+        x += glyph == COLON_GLYPH ? t->font->colon_w : t->font->digit_w;
+    }
+    t->text[n] = 0;
+    lv_obj_set_size(t->obj, x, t->font->h);
+}
+
+static lv_obj_t *sprite_create(lv_obj_t *parent, const lv_font_t *font, const char *text)
+{
+    DigitText *t = sprite_of(NULL);
+    DigitFont *f = get_font(font);
+    if (!t || !f)
+        return NULL;
+
+    t->obj = lv_obj_create(parent);
+    t->font = f;
+    t->color = lv_color_white();
+    lv_obj_remove_style_all(t->obj);
+    lv_obj_clear_flag(t->obj, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_clear_flag(t->obj, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_add_event_cb(t->obj, sprite_delete_cb, LV_EVENT_DELETE, t);
+    sprite_layout(t, text);
+    return t->obj;
+}
+
+static void sprite_set_text(DigitText *t, const char *text)
+{
+    int n = strlen(text);
+    bool same_layout = n == (int)strlen(t->text);
+    for (int i = 0; same_layout && i < n; i++)
+        same_layout = (text[i] == ':') == (t->text[i] == ':');
+    if (!same_layout)
+    {
+        sprite_layout(t, text);
+        return;
+    }
+
+    for (int i = 0; i < n; i++)
+    {
+        if (text[i] == t->text[i])
+            continue;
+        // Same size, so LVGL only invalidates this cell
+        int glyph = glyph_index(text[i]);
+        lv_img_set_src(t->cells[i], glyph >= 0 ? &t->font->cells[glyph] : NULL);
+        t->text[i] = text[i];
+    }
+}
+
+static void sprite_set_color(DigitText *t, lv_color_t color)
+{
+    if (color.full == t->color.full)
+        return;
+    t->color = color;
+    for (int i = 0; t->text[i]; i++)
+        lv_obj_set_style_img_recolor(t->cells[i], color, 0);
+}
+
+// --- Label text (WATCH_DIGIT_SPRITES=0, fallback, benchmark reference) ---
+
+static lv_obj_t *label_create(lv_obj_t *parent, const lv_font_t *font, const char *text)
+{
+    lv_obj_t *label = lv_label_create(parent);
+    lv_obj_set_style_text_font(label, font, 0);
+    lv_obj_set_style_text_color(label, lv_color_white(), 0);
+    lv_label_set_text(label, text);
+    return label;
+}
+
+// --- API ---
+
+lv_obj_t *DigitSprite_Create(lv_obj_t *parent, const lv_font_t *font, const char *text)
+{
+#if WATCH_DIGIT_SPRITES
+    lv_obj_t *obj = sprite_create(parent, font, text);
+    if (obj)
+        return obj;
+#endif
+    return label_create(parent, font, text);
+}
+
+void DigitSprite_SetText(lv_obj_t *obj, const char *text)
+{
+    DigitText *t = sprite_of(obj);
+    if (t)
+        sprite_set_text(t, text);
+    else
+        lv_label_set_text(obj, text);
+}
+
+void DigitSprite_SetColor(lv_obj_t *obj, lv_color_t color)
+{
+    DigitText *t = sprite_of(obj);
+    if (t)
+        sprite_set_color(t, color);
+    else
+        lv_obj_set_style_text_color(obj, color, 0);
+}
+
+// --- Benchmark ---
+#if DISPLAY_BENCH
+#define BENCH_STEPS 20
+
+struct DigitBenchCase
+{
+    const char *name;
+    const lv_font_t *font;
+    uint32_t bg;      // Screen colour, or 0xFFFFFFFF for the home screen (photo + glass)
+    int start;        // Seconds (timer) or minutes (clock) of the first text
+    int step;         // Added per tick
+    bool minutes;     // Text is HH:MM of start minutes, else MM:SS of start seconds
+};
+
+static const DigitBenchCase bench_cases[] = {
+    {"timer second", WATCH_FONT_48, 0x000000, 10 * 60, -1, false}, // 10:00 -> 09:40, timer screen
+    {"clock minute", WATCH_FONT_24, 0xFFFFFFFF, 12 * 60 + 50, 1, true}, // 12:50 -> 13:10, home face
+};
+
+static void bench_text(const DigitBenchCase &c, int i, char *buf)
+{
+    int v = c.start + i * c.step;
+    if (c.minutes)
+        snprintf(buf, 6, "%02d:%02d", (v / 60) % 24, v % 60);
+    else
+        snprintf(buf, 6, "%02d:%02d", v / 60, v % 60);
+}
+
+// Average render + flush time and pixels sent per tick
+static void bench_run(const DigitBenchCase &c, lv_obj_t *parent, bool sprite, uint32_t *us, unsigned long *px)
+{
+    char buf[8];
+    bench_text(c, 0, buf);
+    lv_obj_t *obj = sprite ? sprite_create(parent, c.font, buf) : label_create(parent, c.font, buf);
+    lv_obj_align(obj, LV_ALIGN_CENTER, 0, 0);
+    lv_refr_now(NULL);
+    Display_WaitIdle();
+
+    DisplayStats before, after;
+    Display_GetStats(&before);
+    uint32_t total_us = 0;
+    for (int i = 1; i <= BENCH_STEPS; i++)
+    {
+        bench_text(c, i, buf);
+        uint32_t t0 = micros();
+        DigitSprite_SetText(obj, buf);
+        lv_refr_now(NULL);
+        Display_WaitIdle();
+        total_us += micros() - t0;
+    }
+    Display_GetStats(&after);
+    *us = total_us / BENCH_STEPS;
+    *px = (after.pixels - before.pixels) / BENCH_STEPS;
+
+    lv_obj_del(obj);
+    lv_refr_now(NULL);
+    Display_WaitIdle();
+}
+#endif
+
+void DigitSprite_RunBenchmark()
+{
+#if DISPLAY_BENCH
+    lv_obj_t *home = lv_scr_act();
+    for (const DigitBenchCase &c : bench_cases)
+    {
+        lv_obj_t *scr = home;
+        if (c.bg != 0xFFFFFFFF)
+        {
+            scr = lv_obj_create(NULL);
+            lv_obj_set_style_bg_color(scr, lv_color_hex(c.bg), 0);
+            lv_scr_load(scr);
+        }
+
+        uint32_t label_us, sprite_us;
+        unsigned long label_px, sprite_px;
+        bench_run(c, scr, false, &label_us, &label_px);
+        bench_run(c, scr, true, &sprite_us, &sprite_px);
+        Serial.printf("[bench] digits %-12s label %6lu us %6lu px  sprite %6lu us %6lu px per tick\n", c.name,
+                      (unsigned long)label_us, label_px, (unsigned long)sprite_us, sprite_px);
+
+        if (scr != home)
+        {
+            lv_scr_load(home);
+            lv_obj_del(scr);
+        }
+    }
+    lv_refr_now(NULL);
+    Display_WaitIdle();
+#endif
+}
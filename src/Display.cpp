@@ -0,0 +1,1016 @@
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+#include "Display.h"
+#include "DrawSwar.h"
+
+// --- Display Objects ---
+static TFT_eSPI tft = TFT_eSPI();
+static lv_disp_draw_buf_t draw_buf;
+static lv_disp_drv_t disp_drv;
+static lv_color_t buf1[DISPLAY_WIDTH * DISPLAY_BUF_LINES];
+#if DISPLAY_DMA_FLUSH
+static lv_color_t buf2[DISPLAY_WIDTH * DISPLAY_BUF_LINES]; // LVGL renders here while buf1 is on the wire
+#endif
+
+// --- Statistics ---
+static DisplayStats stats;
+static uint32_t last_flush_end_us = 0;
+static uint32_t last_wire_us = 0;
+static uint32_t stripe_wait_us = 0;
+static bool stripe_follows = false; // Previous flush was not the last of its refresh
+static unsigned long first_frame_us = 0;
+
+// --- Frame Capture ---
+static DisplayCaptureSink capture_sink = NULL;
+static void *capture_ctx = NULL;
+
+// LV_COLOR_16_SWAP=1 renders in the panel's byte order, so stripes go out untouched
+#if LV_COLOR_16_SWAP
+#define FLUSH_SWAP_BYTES false
+#else
+#define FLUSH_SWAP_BYTES true
+#endif
+
+#if DISPLAY_DMA_FLUSH
+static bool dma_in_flight = false;
+static bool bus_open = false;
+#endif
+
+// --- 12-bit Transport ---
+static DisplayTransport transport = DISPLAY_RGB565;
+
+#if DISPLAY_12BIT
+// One stripe at 3 bytes per 2 pixels (+ the half pair of an odd count)
+static uint8_t pack_buf[DISPLAY_WIDTH * DISPLAY_BUF_LINES * 3 / 2 + 2];
+
+// RGB565 as LVGL stores it -> 0x0RGB, keeping the top 4 bits of each channel
+#if LV_COLOR_16_SWAP
+#define RGB565_TO_444(v) ((((v) << 4) & 0xF00) | (((v) << 5) & 0x0E0) | (((v) >> 11) & 0x010) | (((v) >> 9) & 0x00F))
+#else
+#define RGB565_TO_444(v) ((((v) >> 4) & 0xF00) | (((v) >> 3) & 0x0F0) | (((v) >> 1) & 0x00F))
+#endif
+
+// Pack a rectangle (src row stride in pixels) as one continuous RAMWR stream:
+// R1G1 B1R2 G2B2 per pixel pair. Returns the number of bytes written to out.
+static uint32_t pack_rgb444(const uint16_t *src, int stride, int w, int h, uint8_t *out)
+{
+    uint8_t *p = out;
+    int pending = -1; // First pixel of an unfinished pair (pairs span row ends)
+    for (int r = 0; r < h; r++)
+    {
+        const uint16_t *row = src + r * stride;
+        for (int x = 0; x < w; x++)
+        {
+            uint16_t c = RGB565_TO_444(row[x]);
+            if (pending < 0)
+            {
+                pending = c;
+                continue;
+            }
+            *p++ = pending >> 4;
+            *p++ = (uint8_t)(pending << 4) | (c >> 8);
+            *p++ = (uint8_t)c;
+            pending = -1;
+        }
+    }
+    if (pending >= 0)
+    {
+        // The trailing nibble never completes a pixel, so the panel discards it
+        *p++ = pending >> 4;
+        *p++ = (uint8_t)(pending << 4);
+    }
+    return p - out;
+}
+#endif
+
+// --- Frame Memory Mapping ---
+// The ST7789 scrolls its whole 320-line frame memory. Logical row y of the current
+// screen lives at virtual line (row_base + y) mod 320, where virtual line 0 is the
+// first visible GRAM row with the scroll offset at zero. Transitions move row_base.
+static int row_base = 0;
+static int clip_y1 = 0, clip_y2 = DISPLAY_HEIGHT - 1; // Rows flushes may write
+static int dropped_y1 = DISPLAY_HEIGHT, dropped_y2 = -1; // Rows refused by the clip
+
+// Row to hand TFT_eSPI (it adds its own rowstart) for logical row y
+static int panel_row(int y)
+{
+    return (row_base + y + DISPLAY_GRAM_ROW_OFFSET) % DISPLAY_GRAM_ROWS - DISPLAY_GRAM_ROW_OFFSET;
+}
+
+// Rows starting at logical row y that fit before the frame memory wraps
+static int panel_rows_until_wrap(int y)
+{
+    return DISPLAY_GRAM_ROWS - (row_base + y + DISPLAY_GRAM_ROW_OFFSET) % DISPLAY_GRAM_ROWS;
+}
+
+// Trim rows [y, y + *h) to the clip; returns how many leading rows were cut
+static int clip_rows(int y, int *h)
+{
+    int y2 = y + *h - 1;
+    int top = max(y, clip_y1);
+    int bottom = min(y2, clip_y2);
+    if (top > y || bottom < y2)
+    {
+        dropped_y1 = min(dropped_y1, y);
+        dropped_y2 = max(dropped_y2, y2);
+    }
+    *h = bottom >= top ? bottom - top + 1 : 0;
+    return top - y;
+}
+
+// Blocking write of a rectangle (src row stride in pixels), split where the frame memory wraps
+static void push_rect(const uint16_t *src, int stride, int x, int y, int w, int h)
+{
+    while (h > 0)
+    {
+        int rows = min(h, panel_rows_until_wrap(y));
+        tft.setAddrWindow(x, panel_row(y), w, rows);
+#if DISPLAY_12BIT
+        if (transport == DISPLAY_RGB444)
+            tft.pushColors(pack_buf, pack_rgb444(src, stride, w, rows, pack_buf));
+        else
+#endif
+        if (stride == w)
+        {
+            tft.pushColors((uint16_t *)src, w * rows, FLUSH_SWAP_BYTES);
+        }
+        else
+        {
+            for (int r = 0; r < rows; r++)
+                tft.pushColors((uint16_t *)src + r * stride, w, FLUSH_SWAP_BYTES);
+        }
+        src += rows * stride;
+        y += rows;
+        h -= rows;
+    }
+}
+
+// Time the panel needs to clock in a stripe at the configured SPI rate
+static uint32_t wire_time_us(uint32_t pixels)
+{
+    uint32_t bits = transport == DISPLAY_RGB444 ? 12 : 16;
+    return (uint32_t)(((uint64_t)pixels * bits * 1000000) / SPI_FREQUENCY);
+}
+
+// Account the render time of the stripe LVGL just finished. Whatever part of it ran
+// while the previous stripe was still being transmitted counts as overlap.
+static void stats_flush_begin(uint32_t now)
+{
+    if (stripe_follows)
+    {
+        uint32_t render = now - last_flush_end_us - stripe_wait_us;
+        stats.render_us += render;
+        stats.wait_us += stripe_wait_us;
+        stats.wire_us += last_wire_us;
+#if DISPLAY_DMA_FLUSH
+        // If LVGL had to wait, the transfer outlasted the whole render
+        stats.overlap_us += (stripe_wait_us > 0) ? render : min(render, last_wire_us);
+#endif
+    }
+    stripe_wait_us = 0;
+}
+
+static void stats_flush_end(lv_disp_drv_t *disp, uint32_t pixels, uint32_t start)
+{
+    last_flush_end_us = micros();
+    last_wire_us = wire_time_us(pixels);
+    stripe_follows = !lv_disp_flush_is_last(disp);
+    stats.flushes++;
+    stats.pixels += pixels;
+    stats.flush_us += last_flush_end_us - start;
+}
+
+// Hand full-width stripes to the capture sink before they are sent (DMA may swap them in place)
+static void capture_stripe(const lv_area_t *area, const lv_color_t *color_p)
+{
+    if (capture_sink && area->x1 == 0 && area->x2 == DISPLAY_WIDTH - 1)
+        capture_sink(area->y1, area->y2 - area->y1 + 1, (const uint16_t *)color_p, capture_ctx);
+}
+
+// Called by LVGL after every refresh cycle that redrew something
+static void disp_monitor_cb(lv_disp_drv_t *disp, uint32_t time_ms, uint32_t px)
+{
+    if (first_frame_us == 0)
+        first_frame_us = micros();
+    stats.refreshes++;
+    stats.refresh_ms += time_ms;
+    if (time_ms > stats.refresh_max_ms)
+        stats.refresh_max_ms = time_ms;
+}
+
+#if DISPLAY_AREA_MERGE
+// --- Invalid Area Policy ---
+// Snake and Breakout invalidate many small rectangles. Each one becomes its own render
+// pass and flush, so two nearby areas are cheaper as their bounding box once the extra
+// pixels cost less than the extra stripe.
+static uint32_t area_cost_ns = DISPLAY_AREA_COST_US * 1000UL;
+static uint32_t px_cost_ns = DISPLAY_PX_COST_NS;
+
+static uint32_t refresh_cost_ns(const lv_area_t *a)
+{
+    uint32_t w = lv_area_get_width(a);
+    uint32_t h = lv_area_get_height(a);
+    uint32_t rows = DISPLAY_WIDTH * DISPLAY_BUF_LINES / w; // LVGL's rows per stripe
+    uint32_t stripes = (h + rows - 1) / rows;
+    return stripes * area_cost_ns + w * h * px_cost_ns;
+}
+
+// Pixel-pair aligned columns: DrawSwar and the RGB444 packer then work on whole
+// 32-bit words without a lone head pixel per row
+static void disp_rounder_cb(lv_disp_drv_t *disp, lv_area_t *area)
+{
+    area->x1 &= ~1;
+    area->x2 |= 1;
+    if (area->x2 >= disp->hor_res)
+        area->x2 = disp->hor_res - 1;
+}
+
+// Runs after LVGL's own join, right before the areas are rendered
+static void disp_render_start_cb(lv_disp_drv_t *drv)
+{
+    lv_disp_t *disp = _lv_refr_get_disp_refreshing();
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+        for (int i = 0; i < disp->inv_p; i++)
+        {
+            if (disp->inv_area_joined[i])
+                continue;
+            for (int j = i + 1; j < disp->inv_p; j++)
+            {
+                if (disp->inv_area_joined[j])
+                    continue;
+                lv_area_t joined;
+                _lv_area_join(&joined, &disp->inv_areas[i], &disp->inv_areas[j]);
+                if (refresh_cost_ns(&joined) >= refresh_cost_ns(&disp->inv_areas[i]) +
+                                                    refresh_cost_ns(&disp->inv_areas[j]))
+                    continue;
+                // Keep the later slot: LVGL has already picked the last area to render
+                disp->inv_areas[j] = joined;
+                disp->inv_area_joined[i] = 1;
+                stats.areas_merged++;
+                changed = true;
+                break;
+            }
+        }
+    }
+    for (int i = 0; i < disp->inv_p; i++)
+    {
+        if (!disp->inv_area_joined[i])
+            stats.areas++;
+    }
+}
+#endif
+
+#if DISPLAY_DMA_FLUSH
+// Keep the bus claimed for back-to-back DMA stripes
+static void bus_claim()
+{
+    if (!bus_open)
+    {
+        tft.startWrite();
+        bus_open = true;
+    }
+}
+
+// TFT_eSPI does not expose the SPI post-transaction hook, so the DMA-complete event
+// is observed here and forwarded to LVGL as soon as the transfer has drained.
+static bool dma_complete()
+{
+    if (!dma_in_flight)
+        return true;
+    if (tft.dmaBusy())
+        return false;
+
+    dma_in_flight = false;
+    lv_disp_flush_ready(&disp_drv);
+    return true;
+}
+
+// LVGL calls this when it has a finished stripe but the other buffer is still flushing
+static void disp_wait_cb(lv_disp_drv_t *disp)
+{
+    uint32_t start = micros();
+    while (!dma_complete())
+    {
+    }
+    stripe_wait_us += micros() - start;
+}
+
+// Queue a full-width-stride rectangle, split where the frame memory wraps. Returns
+// while the SPI peripheral drains the last part.
+static void dma_push_rect(uint16_t *src, int x, int y, int w, int h)
+{
+    while (h > 0)
+    {
+        int rows = min(h, panel_rows_until_wrap(y));
+        tft.dmaWait(); // pack_buf / the previous part must be off the wire first
+        tft.setAddrWindow(x, panel_row(y), w, rows);
+#if DISPLAY_12BIT
+        if (transport == DISPLAY_RGB444)
+        {
+            uint32_t bytes = pack_rgb444(src, w, w, rows, pack_buf);
+            if ((w * rows) % 4 == 0)
+            {
+                // Whole 16-bit words; byte swapping is off while in this mode
+                tft.pushPixelsDMA((uint16_t *)pack_buf, bytes / 2);
+                dma_in_flight = true;
+            }
+            else
+            {
+                // A padded word would complete one pixel too many, send bytes instead
+                tft.pushColors(pack_buf, bytes);
+            }
+        }
+        else
+#endif
+        {
+            // Swaps the rows in place first unless pre-swapped
+            tft.pushPixelsDMA(src, w * rows);
+            dma_in_flight = true;
+        }
+        src += rows * w;
+        y += rows;
+        h -= rows;
+    }
+}
+
+// --- LVGL Display Flush Function (DMA) ---
+static void disp_flush(lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t *color_p)
+{
+    uint32_t start = micros();
+    stats_flush_begin(start);
+    capture_stripe(area, color_p);
+
+    int w = (area->x2 - area->x1 + 1);
+    int h = (area->y2 - area->y1 + 1);
+    int y = area->y1;
+    uint16_t *src = (uint16_t *)&color_p->full;
+    int skip = clip_rows(y, &h);
+    y += skip;
+    src += skip * w;
+
+    bus_claim();
+    dma_push_rect(src, area->x1, y, w, h);
+
+    stats_flush_end(disp, (area->x2 - area->x1 + 1) * (area->y2 - area->y1 + 1), start);
+    if (!dma_in_flight)
+        lv_disp_flush_ready(disp); // Everything was clipped or sent blocking
+}
+#else
+// --- LVGL Display Flush Function (blocking) ---
+static void disp_flush(lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t *color_p)
+{
+    uint32_t start = micros();
+    stats_flush_begin(start);
+    capture_stripe(area, color_p);
+
+    int w = (area->x2 - area->x1 + 1);
+    int h = (area->y2 - area->y1 + 1);
+    int skip = clip_rows(area->y1, &h);
+    tft.startWrite();
+    push_rect((uint16_t *)&color_p->full + skip * w, w, area->x1, area->y1 + skip, w, h);
+    tft.endWrite();
+
+    stats_flush_end(disp, (area->x2 - area->x1 + 1) * (area->y2 - area->y1 + 1), start);
+    lv_disp_flush_ready(disp);
+}
+#endif
+
+#if DISPLAY_SHADOW_FB
+// --- Shadow Framebuffer ---
+// Mirror of what the panel currently shows, in LVGL byte order. Flushed stripes are
+// diffed against it row by row and only the changed spans are written.
+#define SHADOW_SPAN_GAP 8        // Unchanged gaps shorter than this are cheaper to resend than to re-window
+#define SHADOW_WINDOW_OVERHEAD 11 // CASET + RASET + RAMWR command/data bytes per window
+#define SHADOW_MAX_SCREENS 8
+
+struct ShadowScreenStats
+{
+    lv_obj_t *scr;
+    const char *name;
+    unsigned long bytes_in;   // Bytes LVGL asked to flush
+    unsigned long bytes_sent; // Pixel + window command bytes actually sent
+};
+
+static uint16_t *shadow = NULL;
+static bool shadow_row_valid[DISPLAY_HEIGHT]; // Row matches the panel across its full width
+static ShadowScreenStats shadow_screens[SHADOW_MAX_SCREENS];
+static int shadow_screen_count = 0;
+
+static ShadowScreenStats *shadow_screen_stats()
+{
+    lv_obj_t *scr = lv_scr_act();
+    for (int i = 0; i < shadow_screen_count; i++)
+    {
+        if (shadow_screens[i].scr == scr)
+            return &shadow_screens[i];
+    }
+    if (shadow_screen_count < SHADOW_MAX_SCREENS)
+    {
+        shadow_screens[shadow_screen_count].scr = scr;
+        return &shadow_screens[shadow_screen_count++];
+    }
+    return NULL;
+}
+
+// Write a rectangle of the stripe (row stride = stripe width) through one address window
+static uint32_t shadow_push(const uint16_t *src, int stride, int x, int y, int w, int h)
+{
+    push_rect(src, stride, x, y, w, h);
+    uint32_t bytes = transport == DISPLAY_RGB444 ? (w * h * 3 + 1) / 2 : w * h * 2;
+    return bytes + SHADOW_WINDOW_OVERHEAD;
+}
+
+static void disp_flush_shadow(lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t *color_p)
+{
+    uint32_t start = micros();
+    stats_flush_begin(start);
+    capture_stripe(area, color_p);
+
+    int aw = area->x2 - area->x1 + 1;
+    int ah = area->y2 - area->y1 + 1;
+    const uint16_t *stripe = (const uint16_t *)&color_p->full;
+    uint32_t sent = 0;
+
+    // Pending rectangle: consecutive rows whose only change is the same x range
+    int rect_row = -1, rect_x1 = 0, rect_x2 = 0, rect_rows = 0;
+
+#if DISPLAY_DMA_FLUSH
+    bus_claim();
+#else
+    tft.startWrite();
+#endif
+    for (int r = 0; r < ah; r++)
+    {
+        int y = area->y1 + r;
+        const uint16_t *src = stripe + r * aw;
+        uint16_t *dst = shadow + y * DISPLAY_WIDTH + area->x1;
+
+        int one = 1;
+        if (clip_rows(y, &one) || one == 0)
+        {
+            // Row is not on the panel; close the pending rectangle and keep the shadow as is
+            if (rect_row >= 0)
+                sent += shadow_push(stripe + rect_row * aw + rect_x1, aw, area->x1 + rect_x1,
+                                    area->y1 + rect_row, rect_x2 - rect_x1 + 1, rect_rows);
+            rect_row = -1;
+            continue;
+        }
+
+        // Collect the changed spans of this row, merging short unchanged gaps
+        int span_x1[DISPLAY_WIDTH / 2 + 1];
+        int span_x2[DISPLAY_WIDTH / 2 + 1];
+        int spans = 0;
+        if (!shadow_row_valid[y])
+        {
+            span_x1[0] = 0;
+            span_x2[0] = aw - 1;
+            spans = 1;
+        }
+        else
+        {
+            for (int x = 0; x < aw; x++)
+            {
+                if (src[x] == dst[x])
+                    continue;
+                if (spans > 0 && x - span_x2[spans - 1] <= SHADOW_SPAN_GAP)
+                {
+                    span_x2[spans - 1] = x;
+                }
+                else
+                {
+                    span_x1[spans] = x;
+                    span_x2[spans] = x;
+                    spans++;
+                }
+            }
+        }
+
+        bool extends = spans == 1 && rect_row >= 0 && rect_row + rect_rows == r &&
+                       span_x1[0] == rect_x1 && span_x2[0] == rect_x2;
+        if (extends)
+        {
+            rect_rows++;
+        }
+        else
+        {
+            if (rect_row >= 0)
+                sent += shadow_push(stripe + rect_row * aw + rect_x1, aw, area->x1 + rect_x1,
+                                    area->y1 + rect_row, rect_x2 - rect_x1 + 1, rect_rows);
+            rect_row = -1;
+
+            if (spans == 1)
+            {
+                rect_row = r;
+                rect_x1 = span_x1[0];
+                rect_x2 = span_x2[0];
+                rect_rows = 1;
+            }
+            else
+            {
+                for (int i = 0; i < spans; i++)
+                    sent += shadow_push(src + span_x1[i], aw, area->x1 + span_x1[i], y, span_x2[i] - span_x1[i] + 1, 1);
+            }
+        }
+
+        memcpy(dst, src, aw * 2);
+        if (aw == DISPLAY_WIDTH)
+            shadow_row_valid[y] = true;
+    }
+    if (rect_row >= 0)
+        sent += shadow_push(stripe + rect_row * aw + rect_x1, aw, area->x1 + rect_x1,
+                            area->y1 + rect_row, rect_x2 - rect_x1 + 1, rect_rows);
+#if !DISPLAY_DMA_FLUSH
+    tft.endWrite();
+#endif
+
+    stats.shadow_bytes_in += aw * ah * 2;
+    stats.shadow_bytes_sent += sent;
+    ShadowScreenStats *screen = shadow_screen_stats();
+    if (screen)
+    {
+        screen->bytes_in += aw * ah * 2;
+        screen->bytes_sent += sent;
+    }
+
+    stats_flush_end(disp, aw * ah, start);
+    lv_disp_flush_ready(disp);
+}
+#endif
+
+void Display_BeginPanel()
+{
+    static bool begun = false;
+    if (begun)
+        return;
+    begun = true;
+
+    tft.begin();
+    tft.setRotation(DISPLAY_ROTATION);
+    Display_Command(DISPLAY_INVERTED ? ST7789_INVON : ST7789_INVOFF); // The state PanelFx flashes against
+#if DISPLAY_DMA_FLUSH
+    tft.initDMA();
+    tft.setSwapBytes(FLUSH_SWAP_BYTES);
+#endif
+#if DISPLAY_HW_SCROLL
+    // Whole frame memory is one scroll area: no fixed top/bottom bands
+    const uint8_t scroll_area[] = {0, 0, DISPLAY_GRAM_ROWS >> 8, DISPLAY_GRAM_ROWS & 0xFF, 0, 0};
+    Display_CommandData(ST7789_VSCRDEF, scroll_area, sizeof(scroll_area));
+    Display_SetScrollOffset(0);
+#endif
+}
+
+void Display_Init()
+{
+    Display_BeginPanel();
+
+    // LVGL Driver
+#if DISPLAY_DMA_FLUSH
+    lv_disp_draw_buf_init(&draw_buf, buf1, buf2, DISPLAY_WIDTH * DISPLAY_BUF_LINES);
+#else
+    lv_disp_draw_buf_init(&draw_buf, buf1, NULL, DISPLAY_WIDTH * DISPLAY_BUF_LINES);
+#endif
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.hor_res = DISPLAY_WIDTH;
+    disp_drv.ver_res = DISPLAY_HEIGHT;
+    disp_drv.flush_cb = disp_flush;
+#if DISPLAY_SHADOW_FB
+    shadow = (uint16_t *)heap_caps_malloc(DISPLAY_WIDTH * DISPLAY_HEIGHT * 2, MALLOC_CAP_8BIT);
+    if (shadow)
+        disp_drv.flush_cb = disp_flush_shadow;
+    else
+        Serial.println("[disp] shadow framebuffer allocation failed, diffing disabled");
+#endif
+#if DISPLAY_DMA_FLUSH
+    disp_drv.wait_cb = disp_wait_cb;
+#endif
+    disp_drv.monitor_cb = disp_monitor_cb;
+#if DISPLAY_AREA_MERGE
+    disp_drv.rounder_cb = disp_rounder_cb;
+    disp_drv.render_start_cb = disp_render_start_cb;
+#endif
+    disp_drv.draw_buf = &draw_buf;
+    DrawSwar_Init(&disp_drv);
+    lv_disp_drv_register(&disp_drv);
+}
+
+bool Display_Poll()
+{
+#if DISPLAY_DMA_FLUSH
+    return dma_complete();
+#else
+    return true;
+#endif
+}
+
+void Display_WaitIdle()
+{
+#if DISPLAY_DMA_FLUSH
+    while (!dma_complete())
+    {
+    }
+#endif
+}
+
+void Display_PushFrame(const uint16_t *pixels)
+{
+    Display_WaitIdle();
+#if DISPLAY_DMA_FLUSH
+    bus_claim();
+#else
+    tft.startWrite();
+#endif
+    push_rect(pixels, DISPLAY_WIDTH, 0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT);
+#if !DISPLAY_DMA_FLUSH
+    tft.endWrite();
+#endif
+}
+
+void Display_Capture(DisplayCaptureSink sink, void *ctx)
+{
+    Display_WaitIdle();
+    capture_sink = sink;
+    capture_ctx = ctx;
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    Display_WaitIdle();
+    capture_sink = NULL;
+    capture_ctx = NULL;
+}
+
+// --- Off-screen Rendering ---
+static lv_area_t offscreen_area;
+static uint16_t *offscreen_buf = NULL;
+
+// Stands in for the panel flush: keep the part of the stripe inside offscreen_area
+static void offscreen_flush(lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t *color_p)
+{
+    lv_area_t part;
+    if (_lv_area_intersect(&part, area, &offscreen_area))
+    {
+        int aw = area->x2 - area->x1 + 1;
+        int ow = offscreen_area.x2 - offscreen_area.x1 + 1;
+        for (int y = part.y1; y <= part.y2; y++)
+            memcpy(offscreen_buf + (y - offscreen_area.y1) * ow + (part.x1 - offscreen_area.x1),
+                   &color_p[(y - area->y1) * aw + (part.x1 - area->x1)], (part.x2 - part.x1 + 1) * 2);
+    }
+    lv_disp_flush_ready(disp);
+}
+
+void Display_RenderArea(const lv_area_t *area, uint16_t *pixels)
+{
+    Display_WaitIdle(); // No stripe of an earlier refresh may still be on its way
+    offscreen_area = *area;
+    offscreen_buf = pixels;
+    void (*panel_flush)(lv_disp_drv_t *, const lv_area_t *, lv_color_t *) = disp_drv.flush_cb;
+    disp_drv.flush_cb = offscreen_flush;
+    lv_obj_invalidate_area(lv_scr_act(), area);
+    lv_refr_now(NULL);
+    disp_drv.flush_cb = panel_flush;
+    offscreen_buf = NULL;
+}
+
+void Display_PushArea(const lv_area_t *area, const uint16_t *pixels)
+{
+    int w = area->x2 - area->x1 + 1;
+    int h = area->y2 - area->y1 + 1;
+    Display_WaitIdle();
+#if DISPLAY_DMA_FLUSH
+    bus_claim();
+#else
+    tft.startWrite();
+#endif
+    push_rect(pixels, w, area->x1, area->y1, w, h);
+#if !DISPLAY_DMA_FLUSH
+    tft.endWrite();
+#endif
+#if DISPLAY_SHADOW_FB
+    if (shadow)
+        for (int r = 0; r < h; r++)
+            memcpy(shadow + (area->y1 + r) * DISPLAY_WIDTH + area->x1, pixels + r * w, w * 2);
+#endif
+}
+
+unsigned long Display_FirstFrameUs()
+{
+    return first_frame_us;
+}
+
+// --- Refresh Timer ---
+void Display_SetRefreshPeriod(uint32_t period_ms)
+{
+    lv_timer_t *refr = _lv_disp_get_refr_timer(lv_disp_get_default());
+    if (refr && refr->period != period_ms)
+        lv_timer_set_period(refr, period_ms);
+}
+
+void Display_RefreshSoon()
+{
+    lv_timer_t *refr = _lv_disp_get_refr_timer(lv_disp_get_default());
+    if (refr)
+        lv_timer_ready(refr);
+}
+
+// --- Panel Commands ---
+void Display_Command(uint8_t cmd)
+{
+    Display_CommandData(cmd, NULL, 0);
+}
+
+void Display_CommandData(uint8_t cmd, const uint8_t *data, int len)
+{
+    Display_WaitIdle(); // Never interleave with a stripe on the wire
+    tft.writecommand(cmd);
+    for (int i = 0; i < len; i++)
+        tft.writedata(data[i]);
+}
+
+// --- Transport ---
+void Display_SetTransport(DisplayTransport mode)
+{
+#if DISPLAY_12BIT
+    if (mode == transport)
+        return;
+    // Frame memory keeps its contents, only the interface format changes
+    const uint8_t colmod = mode == DISPLAY_RGB444 ? DISPLAY_COLMOD_12BIT : DISPLAY_COLMOD_16BIT;
+    Display_CommandData(ST7789_COLMOD, &colmod, 1);
+    transport = mode;
+#if DISPLAY_DMA_FLUSH
+    // Packed bytes are already in wire order
+    tft.setSwapBytes(mode == DISPLAY_RGB444 ? false : FLUSH_SWAP_BYTES);
+#endif
+#endif
+}
+
+DisplayTransport Display_GetTransport()
+{
+    return transport;
+}
+
+// --- Hardware Scroll ---
+void Display_SetScrollOffset(int view_line)
+{
+#if DISPLAY_HW_SCROLL
+    int vsp = ((view_line % DISPLAY_GRAM_ROWS) + DISPLAY_GRAM_ROWS) % DISPLAY_GRAM_ROWS;
+#if DISPLAY_ROTATION == 2
+    // MADCTL MY mirrors row addressing against the panel's scan order
+    vsp = (DISPLAY_GRAM_ROWS - vsp) % DISPLAY_GRAM_ROWS;
+#endif
+    const uint8_t start[] = {(uint8_t)(vsp >> 8), (uint8_t)(vsp & 0xFF)};
+    Display_CommandData(ST7789_VSCSAD, start, sizeof(start));
+#endif
+}
+
+int Display_GetRowBase()
+{
+    return row_base;
+}
+
+void Display_SetRowBase(int base)
+{
+    Display_WaitIdle();
+    row_base = ((base % DISPLAY_GRAM_ROWS) + DISPLAY_GRAM_ROWS) % DISPLAY_GRAM_ROWS;
+#if DISPLAY_SHADOW_FB
+    // Logical rows now land on different frame memory lines
+    memset(shadow_row_valid, 0, sizeof(shadow_row_valid));
+#endif
+}
+
+void Display_ResetScroll()
+{
+    Display_SetRowBase(0);
+    Display_SetScrollOffset(0);
+}
+
+void Display_SetRowClip(int y1, int y2)
+{
+    Display_WaitIdle();
+    clip_y1 = y1;
+    clip_y2 = y2;
+}
+
+bool Display_EndRowClip(lv_area_t *dropped)
+{
+    Display_WaitIdle();
+    bool any = dropped_y2 >= dropped_y1;
+    if (any)
+        lv_area_set(dropped, 0, dropped_y1, DISPLAY_WIDTH - 1, dropped_y2);
+    clip_y1 = 0;
+    clip_y2 = DISPLAY_HEIGHT - 1;
+    dropped_y1 = DISPLAY_HEIGHT;
+    dropped_y2 = -1;
+    return any;
+}
+
+void Display_InvalidatePanel()
+{
+#if DISPLAY_SHADOW_FB
+    memset(shadow_row_valid, 0, sizeof(shadow_row_valid));
+#endif
+    lv_obj_invalidate(lv_scr_act());
+}
+
+void Display_NameScreen(lv_obj_t *scr, const char *name)
+{
+#if DISPLAY_SHADOW_FB
+    for (int i = 0; i < shadow_screen_count; i++)
+    {
+        if (shadow_screens[i].scr == scr)
+        {
+            shadow_screens[i].name = name;
+            return;
+        }
+    }
+    if (shadow_screen_count < SHADOW_MAX_SCREENS)
+    {
+        shadow_screens[shadow_screen_count].scr = scr;
+        shadow_screens[shadow_screen_count].name = name;
+        shadow_screen_count++;
+    }
+#endif
+}
+
+void Display_SetAreaCost(unsigned long area_us, unsigned long px_ns)
+{
+#if DISPLAY_AREA_MERGE
+    area_cost_ns = area_us * 1000;
+    px_cost_ns = px_ns;
+#endif
+}
+
+void Display_GetStats(DisplayStats *out)
+{
+    *out = stats;
+}
+
+void Display_ResetStats()
+{
+    memset(&stats, 0, sizeof(stats));
+}
+
+void Display_PrintStats()
+{
+    unsigned long overlap_pct = stats.wire_us ? (stats.overlap_us * 100) / stats.wire_us : 0;
+    unsigned long refresh_avg_ms = stats.refreshes ? stats.refresh_ms / stats.refreshes : 0;
+    Serial.printf("[disp] refreshes=%lu avg=%lums max=%lums areas=%lu merged=%lu\n",
+                  stats.refreshes, refresh_avg_ms, stats.refresh_max_ms, stats.areas, stats.areas_merged);
+    Serial.printf("[disp] %s %s flushes=%lu px=%lu flush=%luus render=%luus wait=%luus overlap=%luus/%luus (%lu%%)\n",
+                  DISPLAY_DMA_FLUSH ? "dma" : "sync", transport == DISPLAY_RGB444 ? "rgb444" : "rgb565",
+                  stats.flushes, stats.pixels, stats.flush_us, stats.render_us,
+                  stats.wait_us, stats.overlap_us, stats.wire_us, overlap_pct);
+#if DISPLAY_SHADOW_FB
+    Serial.printf("[disp] shadow in=%lu sent=%lu saved=%ld bytes\n", stats.shadow_bytes_in,
+                  stats.shadow_bytes_sent, (long)(stats.shadow_bytes_in - stats.shadow_bytes_sent));
+    // Per-screen totals since boot, to judge where the 64,800-byte shadow pays off
+    for (int i = 0; i < shadow_screen_count; i++)
+    {
+        ShadowScreenStats *s = &shadow_screens[i];
+        Serial.printf("[disp]   %-8s in=%lu sent=%lu saved=%ld\n", s->name ? s->name : "?",
+                      s->bytes_in, s->bytes_sent, (long)(s->bytes_in - s->bytes_sent));
+    }
+#endif
+}
+
+// Average time to render and flush one invalidated area of the active screen
+static uint32_t bench_refresh_us(const lv_area_t *area, int reps)
+{
+    lv_disp_t *disp = lv_disp_get_default();
+    uint32_t start = micros();
+    for (int i = 0; i < reps; i++)
+    {
+        lv_obj_invalidate_area(lv_scr_act(), area);
+        lv_refr_now(disp);
+        Display_WaitIdle();
+    }
+    return (micros() - start) / reps;
+}
+
+// Push full frames of a test pattern through the blocking and DMA paths, with and
+// without the per-pixel byte swap, then packed as RGB444, and report the throughput of each.
+// The panel line times a full redraw per pixel, to compare builds for different panel sizes.
+void Display_RunBenchmark()
+{
+    const int frames = 10;
+    const uint32_t stripe_px = DISPLAY_WIDTH * DISPLAY_BUF_LINES;
+    const uint32_t frame_bytes = DISPLAY_WIDTH * DISPLAY_HEIGHT * 2;
+    uint32_t wire_us = UINT32_MAX; // Fastest RGB565 full-frame push
+
+    Display_WaitIdle();
+    for (uint32_t i = 0; i < stripe_px; i++)
+        buf1[i].full = (uint16_t)(i * 0x0841);
+
+#if DISPLAY_DMA_FLUSH
+    const int paths = 2;
+    bus_claim();
+#else
+    const int paths = 1;
+    tft.startWrite();
+#endif
+    for (int path = 0; path < paths; path++)
+    {
+        for (int swap = 1; swap >= 0; swap--)
+        {
+            uint32_t start = micros();
+            for (int f = 0; f < frames; f++)
+            {
+                for (int y = 0; y < DISPLAY_HEIGHT; y += DISPLAY_BUF_LINES)
+                {
+                    int h = min(DISPLAY_BUF_LINES, DISPLAY_HEIGHT - y);
+#if DISPLAY_DMA_FLUSH
+                    if (path == 1)
+                    {
+                        tft.setSwapBytes(swap);
+                        tft.pushImageDMA(0, y, DISPLAY_WIDTH, h, (uint16_t *)buf1);
+                        continue;
+                    }
+#endif
+                    tft.setAddrWindow(0, y, DISPLAY_WIDTH, h);
+                    tft.pushColors((uint16_t *)buf1, DISPLAY_WIDTH * h, swap);
+                }
+            }
+#if DISPLAY_DMA_FLUSH
+            tft.dmaWait();
+#endif
+            uint32_t us = micros() - start;
+            wire_us = min(wire_us, us / frames);
+            Serial.printf("[bench] flush %s %-11s %6lu us/frame %6lu KB/s\n",
+                          path ? "dma " : "sync", swap ? "swapped" : "pre-swapped",
+                          (unsigned long)(us / frames),
+                          (unsigned long)(((uint64_t)frame_bytes * frames * 1000) / (us ? us : 1) / 1024));
+        }
+    }
+#if DISPLAY_DMA_FLUSH
+    tft.setSwapBytes(FLUSH_SWAP_BYTES);
+#endif
+
+#if DISPLAY_12BIT
+    // Same frames through the flush helpers, packed to 12 bits on the fly
+    DisplayTransport prev = transport;
+    Display_SetTransport(DISPLAY_RGB444);
+    for (int path = 0; path < paths; path++)
+    {
+        uint32_t start = micros();
+        for (int f = 0; f < frames; f++)
+        {
+            for (int y = 0; y < DISPLAY_HEIGHT; y += DISPLAY_BUF_LINES)
+            {
+                int h = min(DISPLAY_BUF_LINES, DISPLAY_HEIGHT - y);
+#if DISPLAY_DMA_FLUSH
+                if (path == 1)
+                {
+                    dma_push_rect((uint16_t *)buf1, 0, y, DISPLAY_WIDTH, h);
+                    continue;
+                }
+#endif
+                push_rect((uint16_t *)buf1, DISPLAY_WIDTH, 0, y, DISPLAY_WIDTH, h);
+            }
+        }
+#if DISPLAY_DMA_FLUSH
+        tft.dmaWait();
+        dma_in_flight = false; // Not an LVGL stripe, nothing to report
+#endif
+        uint32_t us = micros() - start;
+        Serial.printf("[bench] flush %s %-11s %6lu us/frame %6lu KB/s (%lu KB/s rgb565-equivalent)\n",
+                      path ? "dma " : "sync", "rgb444", (unsigned long)(us / frames),
+                      (unsigned long)(((uint64_t)frame_bytes * 3 / 4 * frames * 1000) / (us ? us : 1) / 1024),
+                      (unsigned long)(((uint64_t)frame_bytes * frames * 1000) / (us ? us : 1) / 1024));
+    }
+    Display_SetTransport(prev);
+#endif
+#if !DISPLAY_DMA_FLUSH
+    tft.endWrite();
+#endif
+
+    // Render + flush of the whole active screen; the render share is what the wire does not explain
+    lv_area_t full_area;
+    lv_area_set(&full_area, 0, 0, DISPLAY_WIDTH - 1, DISPLAY_HEIGHT - 1);
+    uint32_t full_us = bench_refresh_us(&full_area, frames);
+    Serial.printf("[bench] panel %dx%d: %d stripes of %d rows, full redraw %6lu us (%lu ns/px, %lu fps), "
+                  "wire %6lu us, render ~%6lu us\n",
+                  DISPLAY_WIDTH, DISPLAY_HEIGHT, (DISPLAY_HEIGHT + DISPLAY_BUF_LINES - 1) / DISPLAY_BUF_LINES,
+                  DISPLAY_BUF_LINES, (unsigned long)full_us,
+                  (unsigned long)((uint64_t)full_us * 1000 / (DISPLAY_WIDTH * DISPLAY_HEIGHT)),
+                  (unsigned long)(1000000UL / (full_us ? full_us : 1)), (unsigned long)wire_us,
+                  (unsigned long)(full_us > wire_us ? full_us - wire_us : 0));
+
+#if DISPLAY_AREA_MERGE
+    // Merge cost model: full refreshes of a small and a one-stripe area of the current screen
+    lv_area_t small_area, stripe_area;
+    lv_area_set(&small_area, 0, 0, 7, 7);
+    lv_area_set(&stripe_area, 0, 0, DISPLAY_WIDTH - 1, DISPLAY_BUF_LINES - 1);
+    uint32_t small_us = bench_refresh_us(&small_area, frames * 4);
+    uint32_t stripe_us = bench_refresh_us(&stripe_area, frames);
+    uint32_t small_px = lv_area_get_size(&small_area);
+    uint32_t stripe_px_n = lv_area_get_size(&stripe_area);
+    unsigned long px_ns = stripe_us > small_us ? (stripe_us - small_us) * 1000UL / (stripe_px_n - small_px) : 0;
+    unsigned long area_us = small_us - min((unsigned long)small_us, px_ns * small_px / 1000);
+    Serial.printf("[bench] area cost %lu us + %lu ns/px (-D DISPLAY_AREA_COST_US=%lu -D DISPLAY_PX_COST_NS=%lu)\n",
+                  area_us, px_ns, area_us, px_ns);
+    Display_SetAreaCost(area_us, px_ns);
+#endif
+
+    // Repaint whatever the pattern overwrote
+    Display_InvalidatePanel();
+}
@@ -0,0 +1,446 @@
+#include <Arduino.h>
+#include "DrawSwar.h"
+#include "Display.h"
+
+#if DRAW_SWAR
+// --- Pixel Pair Helpers ---
+// A 32-bit word holds two RGB565 pixels, the left one in the low half. Channels are
+// split into one 16-bit lane per pixel so a single multiply weights both pixels.
+#define LANE_R(w) (((w) >> 11) & 0x001F001F)
+#define LANE_G(w) (((w) >> 5) & 0x003F003F)
+#define LANE_B(w) ((w) & 0x001F001F)
+
+// Same arithmetic as lv_color_mix, so kernel output matches the stock renderer bit for bit
+#if LV_COLOR_MIX_ROUND_OFS == 0
+#define MIX_WEIGHT(opa) (((uint32_t)(opa) + 4) >> 3) // 5-bit weight, truncating
+#define MIX_ONE 32
+#define MIX_BIAS 0
+#define MIX_DIV(t) ((t) >> 5)
+#else
+#define MIX_WEIGHT(opa) ((uint32_t)(opa)) // LV_UDIV255(x + LV_COLOR_MIX_ROUND_OFS) per lane
+#define MIX_ONE 255
+#define MIX_BIAS ((LV_COLOR_MIX_ROUND_OFS + 1) * 0x00010001)
+#define MIX_DIV(t) (((t) + (((t) >> 8) & 0x00FF00FF)) >> 8)
+#endif
+
+// Stored pixel pair <-> plain RGB565 (LV_COLOR_16_SWAP keeps each pixel byte swapped)
+static inline uint32_t pair_native(uint32_t w)
+{
+#if LV_COLOR_16_SWAP
+    return ((w >> 8) & 0x00FF00FF) | ((w << 8) & 0xFF00FF00);
+#else
+    return w;
+#endif
+}
+
+// Foreground channels pre-weighted for a fixed colour/opacity
+struct MixFg
+{
+    uint32_t r, g, b;
+    uint32_t inv; // Background weight
+};
+
+static inline void mix_fg_init(MixFg *fg, uint32_t pair, uint32_t m)
+{
+    fg->r = LANE_R(pair) * m + MIX_BIAS;
+    fg->g = LANE_G(pair) * m + MIX_BIAS;
+    fg->b = LANE_B(pair) * m + MIX_BIAS;
+    fg->inv = MIX_ONE - m;
+}
+
+static inline uint32_t mix_bg(const MixFg *fg, uint32_t bg)
+{
+    uint32_t r = MIX_DIV(fg->r + LANE_R(bg) * fg->inv) & 0x001F001F;
+    uint32_t g = MIX_DIV(fg->g + LANE_G(bg) * fg->inv) & 0x003F003F;
+    uint32_t b = MIX_DIV(fg->b + LANE_B(bg) * fg->inv) & 0x001F001F;
+    return (r << 11) | (g << 5) | b;
+}
+
+// Two stored pixels (native order) mixed with weight m of MIX_ONE
+static inline uint32_t mix_pair(uint32_t fg, uint32_t bg, uint32_t m)
+{
+    MixFg f;
+    mix_fg_init(&f, fg, m);
+    return mix_bg(&f, bg);
+}
+
+static inline uint16_t mix_px(uint16_t fg, uint16_t bg, lv_opa_t opa)
+{
+    return (uint16_t)pair_native(mix_pair(pair_native(fg), pair_native(bg), MIX_WEIGHT(opa)));
+}
+
+// Source pixels are not necessarily word aligned when the destination is
+static inline uint32_t load_pair(const uint16_t *p)
+{
+    return p[0] | ((uint32_t)p[1] << 16);
+}
+
+// --- Kernels ---
+// Each works on a w x h block; strides are in pixels (mask stride in bytes).
+// A leading odd pixel is handled alone so the pair loop only does aligned word access.
+
+static void IRAM_ATTR fill_cover(uint16_t *dst, int stride, int w, int h, uint16_t c)
+{
+    uint32_t c2 = c | ((uint32_t)c << 16);
+    for (int y = 0; y < h; y++, dst += stride)
+    {
+        uint16_t *p = dst;
+        int n = w;
+        if (((uintptr_t)p & 2) && n > 0)
+        {
+            *p++ = c;
+            n--;
+        }
+        uint32_t *p32 = (uint32_t *)p;
+        for (; n >= 8; n -= 8, p32 += 4)
+        {
+            p32[0] = c2;
+            p32[1] = c2;
+            p32[2] = c2;
+            p32[3] = c2;
+        }
+        for (; n >= 2; n -= 2)
+            *p32++ = c2;
+        if (n)
+            *(uint16_t *)p32 = c;
+    }
+}
+
+static void IRAM_ATTR fill_mix(uint16_t *dst, int stride, int w, int h, uint16_t c, lv_opa_t opa)
+{
+    MixFg fg;
+    mix_fg_init(&fg, pair_native(c | ((uint32_t)c << 16)), MIX_WEIGHT(opa));
+    for (int y = 0; y < h; y++, dst += stride)
+    {
+        uint16_t *p = dst;
+        int n = w;
+        if (((uintptr_t)p & 2) && n > 0)
+        {
+            *p = (uint16_t)pair_native(mix_bg(&fg, pair_native(*p)));
+            p++;
+            n--;
+        }
+        uint32_t *p32 = (uint32_t *)p;
+        for (; n >= 2; n -= 2, p32++)
+            *p32 = pair_native(mix_bg(&fg, pair_native(*p32)));
+        if (n)
+        {
+            p = (uint16_t *)p32;
+            *p = (uint16_t)pair_native(mix_bg(&fg, pair_native(*p)));
+        }
+    }
+}
+
+// Per-pixel opacity from an A8 mask (glyphs, rounded corners, alpha images as a mask)
+static inline lv_opa_t mask_opa(lv_opa_t m, lv_opa_t opa)
+{
+    if (opa >= LV_OPA_MAX)
+        return m;
+    return m >= LV_OPA_MAX ? opa : (lv_opa_t)(((uint32_t)m * opa) >> 8);
+}
+
+static void IRAM_ATTR fill_mask(uint16_t *dst, int stride, int w, int h, uint16_t c, lv_opa_t opa,
+                                const lv_opa_t *mask, int mstride)
+{
+    uint32_t c2 = c | ((uint32_t)c << 16);
+    for (int y = 0; y < h; y++, dst += stride, mask += mstride)
+    {
+        int x = 0;
+        if (((uintptr_t)dst & 2) && w > 0)
+        {
+            lv_opa_t o = mask_opa(mask[0], opa);
+            if (o)
+                dst[0] = o == LV_OPA_COVER ? c : mix_px(c, dst[0], o);
+            x = 1;
+        }
+        for (; x + 1 < w; x += 2)
+        {
+            lv_opa_t m0 = mask[x], m1 = mask[x + 1];
+            if ((m0 | m1) == 0)
+                continue; // Outside the glyph: most of a text box
+            if ((m0 & m1) == LV_OPA_COVER && opa >= LV_OPA_MAX)
+            {
+                *(uint32_t *)&dst[x] = c2;
+                continue;
+            }
+            lv_opa_t o0 = mask_opa(m0, opa), o1 = mask_opa(m1, opa);
+            if (o0)
+                dst[x] = o0 == LV_OPA_COVER ? c : mix_px(c, dst[x], o0);
+            if (o1)
+                dst[x + 1] = o1 == LV_OPA_COVER ? c : mix_px(c, dst[x + 1], o1);
+        }
+        if (x < w)
+        {
+            lv_opa_t o = mask_opa(mask[x], opa);
+            if (o)
+                dst[x] = o == LV_OPA_COVER ? c : mix_px(c, dst[x], o);
+        }
+    }
+}
+
+static void IRAM_ATTR map_cover(uint16_t *dst, int stride, const uint16_t *src, int sstride, int w, int h)
+{
+    for (int y = 0; y < h; y++, dst += stride, src += sstride)
+        memcpy(dst, src, w * 2);
+}
+
+static void IRAM_ATTR map_mix(uint16_t *dst, int stride, const uint16_t *src, int sstride, int w, int h,
+                              lv_opa_t opa)
+{
+    uint32_t m = MIX_WEIGHT(opa);
+    for (int y = 0; y < h; y++, dst += stride, src += sstride)
+    {
+        int x = 0;
+        if (((uintptr_t)dst & 2) && w > 0)
+        {
+            dst[0] = mix_px(src[0], dst[0], opa);
+            x = 1;
+        }
+        for (; x + 1 < w; x += 2)
+        {
+            uint32_t *d = (uint32_t *)&dst[x];
+            *d = pair_native(mix_pair(pair_native(load_pair(&src[x])), pair_native(*d), m));
+        }
+        if (x < w)
+            dst[x] = mix_px(src[x], dst[x], opa);
+    }
+}
+
+static void IRAM_ATTR map_mask(uint16_t *dst, int stride, const uint16_t *src, int sstride, int w, int h,
+                               lv_opa_t opa, const lv_opa_t *mask, int mstride)
+{
+    for (int y = 0; y < h; y++, dst += stride, src += sstride, mask += mstride)
+    {
+        int x = 0;
+        if (((uintptr_t)dst & 2) && w > 0)
+        {
+            lv_opa_t o = mask_opa(mask[0], opa);
+            if (o)
+                dst[0] = o == LV_OPA_COVER ? src[0] : mix_px(src[0], dst[0], o);
+            x = 1;
+        }
+        for (; x + 1 < w; x += 2)
+        {
+            lv_opa_t m0 = mask[x], m1 = mask[x + 1];
+            if ((m0 | m1) == 0)
+                continue; // Transparent corners of an icon
+            if ((m0 & m1) == LV_OPA_COVER && opa >= LV_OPA_MAX)
+            {
+                *(uint32_t *)&dst[x] = load_pair(&src[x]);
+                continue;
+            }
+            lv_opa_t o0 = mask_opa(m0, opa), o1 = mask_opa(m1, opa);
+            if (o0)
+                dst[x] = o0 == LV_OPA_COVER ? src[x] : mix_px(src[x], dst[x], o0);
+            if (o1)
+                dst[x + 1] = o1 == LV_OPA_COVER ? src[x + 1] : mix_px(src[x + 1], dst[x + 1], o1);
+        }
+        if (x < w)
+        {
+            lv_opa_t o = mask_opa(mask[x], opa);
+            if (o)
+                dst[x] = o == LV_OPA_COVER ? src[x] : mix_px(src[x], dst[x], o);
+        }
+    }
+}
+
+// --- Draw Context ---
+static void IRAM_ATTR swar_blend(lv_draw_ctx_t *draw_ctx, const lv_draw_sw_blend_dsc_t *dsc)
+{
+    lv_disp_t *disp = _lv_refr_get_disp_refreshing();
+    if (dsc->blend_mode != LV_BLEND_MODE_NORMAL || disp->driver->set_px_cb || disp->driver->screen_transp)
+    {
+        lv_draw_sw_blend_basic(draw_ctx, dsc);
+        return;
+    }
+
+    const lv_opa_t *mask = dsc->mask_buf;
+    if (mask && dsc->mask_res == LV_DRAW_MASK_RES_TRANSP)
+        return;
+    if (dsc->mask_res == LV_DRAW_MASK_RES_FULL_COVER)
+        mask = NULL;
+
+    lv_area_t area;
+    if (!_lv_area_intersect(&area, dsc->blend_area, draw_ctx->clip_area))
+        return;
+
+    int w = lv_area_get_width(&area);
+    int h = lv_area_get_height(&area);
+    int stride = lv_area_get_width(draw_ctx->buf_area);
+    uint16_t *dst = (uint16_t *)draw_ctx->buf + stride * (area.y1 - draw_ctx->buf_area->y1) +
+                    (area.x1 - draw_ctx->buf_area->x1);
+
+    int mstride = 0;
+    if (mask)
+    {
+        mstride = lv_area_get_width(dsc->mask_area);
+        mask += mstride * (area.y1 - dsc->mask_area->y1) + (area.x1 - dsc->mask_area->x1);
+    }
+
+    lv_opa_t opa = dsc->opa;
+    if (dsc->src_buf == NULL)
+    {
+        uint16_t c = dsc->color.full;
+        if (mask)
+            fill_mask(dst, stride, w, h, c, opa, mask, mstride);
+        else if (opa >= LV_OPA_MAX)
+            fill_cover(dst, stride, w, h, c);
+        else
+            fill_mix(dst, stride, w, h, c, opa);
+        return;
+    }
+
+    int sstride = lv_area_get_width(dsc->blend_area);
+    const uint16_t *src = (const uint16_t *)dsc->src_buf + sstride * (area.y1 - dsc->blend_area->y1) +
+                          (area.x1 - dsc->blend_area->x1);
+    if (mask)
+        map_mask(dst, stride, src, sstride, w, h, opa, mask, mstride);
+    else if (opa >= LV_OPA_MAX)
+        map_cover(dst, stride, src, sstride, w, h);
+    else
+        map_mix(dst, stride, src, sstride, w, h, opa);
+}
+
+static void swar_ctx_init(lv_disp_drv_t *drv, lv_draw_ctx_t *draw_ctx)
+{
+    // Stock software context (rect/label/img/line renderers), only the blend step replaced
+    lv_draw_sw_init_ctx(drv, draw_ctx);
+    ((lv_draw_sw_ctx_t *)draw_ctx)->blend = swar_blend;
+}
+#endif
+
+void DrawSwar_Init(lv_disp_drv_t *drv)
+{
+#if DRAW_SWAR
+    drv->draw_ctx_init = swar_ctx_init;
+    drv->draw_ctx_deinit = lv_draw_sw_deinit_ctx;
+    drv->draw_ctx_size = sizeof(lv_draw_sw_ctx_t);
+#endif
+}
+
+// --- Benchmark ---
+// Runs each hot case through lv_draw_sw_blend_basic and the pair kernels on the same
+// draw stripe of this panel, and checks both produce the same pixels.
+#if DRAW_SWAR
+#define BENCH_W DISPLAY_WIDTH
+#define BENCH_H DISPLAY_BUF_LINES
+
+struct BenchCase
+{
+    const char *name;
+    int w, h;
+    bool image;   // src_buf (image) or plain colour
+    bool masked;  // A8 mask (glyph / alpha channel)
+    lv_opa_t opa;
+    int reps;
+};
+
+static const BenchCase bench_cases[] = {
+    {"snake cell", 11, 11, false, false, LV_OPA_COVER, 400}, // 160 parts + background per frame
+    {"brick", 21, 10, false, false, LV_OPA_COVER, 400},
+    {"fill strip", BENCH_W, BENCH_H, false, false, LV_OPA_COVER, 50},
+    {"glass 40%", 120, BENCH_H, false, false, LV_OPA_40, 50},
+    {"img copy", BENCH_W, BENCH_H, true, false, LV_OPA_COVER, 50},
+    {"img 40%", 120, BENCH_H, true, false, LV_OPA_40, 50},
+    {"icon argb", 30, 30, true, true, LV_OPA_COVER, 200},
+    {"text a8", BENCH_W, 24, false, true, LV_OPA_COVER, 50},
+};
+
+static void bench_pattern(uint16_t *buf, int n)
+{
+    for (int i = 0; i < n; i++)
+        buf[i] = (uint16_t)(i * 0x0841 + (i >> 3));
+}
+
+static uint32_t bench_run(void (*blend)(lv_draw_ctx_t *, const lv_draw_sw_blend_dsc_t *),
+                          lv_draw_ctx_t *ctx, const lv_draw_sw_blend_dsc_t *dsc, int reps)
+{
+    uint32_t start = micros();
+    for (int i = 0; i < reps; i++)
+        blend(ctx, dsc);
+    return micros() - start;
+}
+#endif
+
+void DrawSwar_RunBenchmark()
+{
+#if DRAW_SWAR
+    const int px = BENCH_W * BENCH_H;
+    uint16_t *ref = (uint16_t *)malloc(px * 2);
+    uint16_t *out = (uint16_t *)malloc(px * 2);
+    uint16_t *src = (uint16_t *)malloc(px * 2);
+    lv_opa_t *mask = (lv_opa_t *)malloc(px);
+    if (!ref || !out || !src || !mask)
+    {
+        Serial.println("[bench] draw: out of memory");
+        free(ref);
+        free(out);
+        free(src);
+        free(mask);
+        return;
+    }
+
+    bench_pattern(src, px);
+    for (int i = 0; i < px; i++)
+    {
+        // Mostly fully in or out with antialiased edges, like glyphs and icons
+        int v = (i * 37) % 97;
+        mask[i] = v < 40 ? 0 : v < 80 ? 255 : (lv_opa_t)(v * 2);
+    }
+
+    lv_area_t buf_area;
+    lv_area_set(&buf_area, 0, 0, BENCH_W - 1, BENCH_H - 1);
+    lv_draw_sw_ctx_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.base_draw.buf_area = &buf_area;
+    ctx.base_draw.clip_area = &buf_area;
+
+    // lv_draw_sw_blend_basic reads the driver of the display being refreshed
+    lv_disp_t *prev = _lv_refr_get_disp_refreshing();
+    _lv_refr_set_disp_refreshing(lv_disp_get_default());
+
+    for (size_t i = 0; i < sizeof(bench_cases) / sizeof(bench_cases[0]); i++)
+    {
+        const BenchCase *bc = &bench_cases[i];
+        lv_area_t area;
+        lv_area_set(&area, 1, 0, bc->w, bc->h - 1); // Odd x1: exercises the unaligned head pixel
+        lv_draw_sw_blend_dsc_t dsc;
+        memset(&dsc, 0, sizeof(dsc));
+        dsc.blend_area = &area;
+        dsc.color = lv_color_make(0x00, 0xFF, 0x41);
+        dsc.opa = bc->opa;
+        dsc.blend_mode = LV_BLEND_MODE_NORMAL;
+        dsc.src_buf = bc->image ? (const lv_color_t *)src : NULL;
+        dsc.mask_buf = bc->masked ? mask : NULL;
+        dsc.mask_area = &area;
+        dsc.mask_res = bc->masked ? LV_DRAW_MASK_RES_CHANGED : LV_DRAW_MASK_RES_FULL_COVER;
+
+        // One pass each from the same start for the pixel comparison
+        bench_pattern(ref, px);
+        bench_pattern(out, px);
+        ctx.base_draw.buf = ref;
+        lv_draw_sw_blend_basic(&ctx.base_draw, &dsc);
+        ctx.base_draw.buf = out;
+        swar_blend(&ctx.base_draw, &dsc);
+        unsigned long diff = 0;
+        for (int p = 0; p < px; p++)
+            diff += ref[p] != out[p];
+
+        ctx.base_draw.buf = ref;
+        uint32_t stock_us = bench_run(lv_draw_sw_blend_basic, &ctx.base_draw, &dsc, bc->reps);
+        ctx.base_draw.buf = out;
+        uint32_t swar_us = bench_run(swar_blend, &ctx.base_draw, &dsc, bc->reps);
+
+        unsigned long x100 = swar_us ? (unsigned long)stock_us * 100 / swar_us : 0;
+        Serial.printf("[bench] draw %-10s %3dx%-3d stock %6lu us swar %6lu us x%lu.%02lu diff=%lu px\n",
+                      bc->name, bc->w, bc->h, (unsigned long)stock_us, (unsigned long)swar_us,
+                      x100 / 100, x100 % 100, diff);
+    }
+
+    _lv_refr_set_disp_refreshing(prev);
+    free(ref);
+    free(out);
+    free(src);
+    free(mask);
+#endif
+}
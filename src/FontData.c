@@ -0,0 +1,7 @@
+// C translation unit for the generated font subsets: the LVGL font structs use
+// designated initializers the way lv_font_conv writes them.
+#include "Fonts.h"
+
+#if WATCH_FONT_SUBSET
+#include "watch_fonts.h" // Generated by tools/asset_pipeline.py
+#endif
@@ -0,0 +1,90 @@
+#include <Arduino.h>
+#include "Fonts.h"
+#include "Display.h"
+
+// --- Benchmark ---
+// Only this references the full Montserrat fonts, so they are linked with DISPLAY_BENCH alone
+#if DISPLAY_BENCH && WATCH_FONT_SUBSET
+#define BENCH_PASSES 20
+
+struct FontBenchCase
+{
+    const char *name;
+    const lv_font_t *full;
+    const lv_font_t *subset;
+    const char *text; // What the screens draw in this size
+};
+
+static const FontBenchCase bench_cases[] = {
+    {"14", &lv_font_montserrat_14, &watch_font_14,
+     "Score: 120 Lives: 3 GREATER NOIDA 4.2 km/h Rain: 35% Clear Sky " LV_SYMBOL_PLAY LV_SYMBOL_LEFT LV_SYMBOL_RIGHT
+     LV_SYMBOL_OK LV_SYMBOL_UP LV_SYMBOL_DOWN LV_SYMBOL_PAUSE LV_SYMBOL_WARNING},
+    {"24", &lv_font_montserrat_24, &watch_font_24, "12:34 -3.5°C SNAKE BREAKOUT TIMER"},
+    {"48", &lv_font_montserrat_48, &watch_font_48, "0123456789:--:--"},
+};
+
+// Descriptor + bitmap for every letter of text, like the label renderer does per glyph
+static uint32_t bench_fetch(const lv_font_t *font, const char *text)
+{
+    lv_font_glyph_dsc_t g;
+    uint32_t t0 = micros();
+    for (int pass = 0; pass < BENCH_PASSES; pass++)
+    {
+        uint32_t i = 0;
+        while (text[i])
+        {
+            uint32_t letter = _lv_txt_encoded_next(text, &i);
+            if (lv_font_get_glyph_dsc(font, &g, letter, 0))
+                lv_font_get_glyph_bitmap(font, letter);
+        }
+    }
+    return micros() - t0;
+}
+
+// Letters whose metrics or pixels differ between the two fonts
+static unsigned long bench_diff(const FontBenchCase &c, int *letters)
+{
+    unsigned long diff = 0;
+    uint32_t i = 0;
+    *letters = 0;
+    while (c.text[i])
+    {
+        uint32_t letter = _lv_txt_encoded_next(c.text, &i);
+        lv_font_glyph_dsc_t a, b;
+        bool has_a = lv_font_get_glyph_dsc(c.full, &a, letter, 0);
+        bool has_b = lv_font_get_glyph_dsc(c.subset, &b, letter, 0);
+        (*letters)++;
+        if (has_a != has_b || a.adv_w != b.adv_w || a.box_w != b.box_w || a.box_h != b.box_h ||
+            a.ofs_x != b.ofs_x || a.ofs_y != b.ofs_y)
+        {
+            diff++;
+            continue;
+        }
+        // The full fonts are plain, so their bitmap stays put while a compressed subset
+        // decodes into LVGL's shared buffer
+        const uint8_t *pa = lv_font_get_glyph_bitmap(c.full, letter);
+        const uint8_t *pb = lv_font_get_glyph_bitmap(c.subset, letter);
+        size_t bytes = ((size_t)a.box_w * a.box_h * a.bpp + 7) / 8;
+        if (bytes && (!pa || !pb || memcmp(pa, pb, bytes) != 0))
+            diff++;
+    }
+    return diff;
+}
+#endif
+
+void Fonts_RunBenchmark()
+{
+#if DISPLAY_BENCH && WATCH_FONT_SUBSET
+    for (const FontBenchCase &c : bench_cases)
+    {
+        int letters;
+        unsigned long diff = bench_diff(c, &letters);
+        uint32_t full_us = bench_fetch(c.full, c.text);
+        uint32_t subset_us = bench_fetch(c.subset, c.text);
+        unsigned long fetches = (unsigned long)letters * BENCH_PASSES;
+        Serial.printf("[bench] font %s full %5lu ns/glyph  subset%s %5lu ns/glyph  diff=%lu of %d glyphs\n",
+                      c.name, (unsigned long)(full_us * 1000ULL / fetches), WATCH_FONT_COMPRESSED ? " (rle)" : "",
+                      (unsigned long)(subset_us * 1000ULL / fetches), diff, letters);
+    }
+#endif
+}
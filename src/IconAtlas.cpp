@@ -0,0 +1,71 @@
+#include <Arduino.h>
+#include "IconAtlas.h"
+#include "AssetStore.h"
+#include "weather_icon_atlas.h" // Generated: tints, and the only translation unit that links the pixels
+
+#define ICON_SIZE 30
+#define ICON_BYTES (ICON_SIZE * ICON_SIZE * WEATHER_ICON_ATLAS_BPP)
+#define ATLAS_BYTES (WEATHER_ICON_COUNT * ICON_BYTES)
+
+static lv_img_dsc_t icons[WEATHER_ICON_COUNT];
+
+#if WATCH_ASSET_STORE
+static const uint8_t *atlas_pixels()
+{
+    const lv_img_dsc_t *atlas = AssetStore_Mount() ? AssetStore_Image("weather_icons") : NULL;
+    if (!atlas || atlas->header.cf != WEATHER_ICON_ATLAS_CF || atlas->data_size != ATLAS_BYTES)
+    {
+        Serial.println("IconAtlas: weather_icons not in the asset store");
+        return NULL;
+    }
+    return atlas->data;
+}
+#else
+static_assert(sizeof(weather_icon_atlas) == ATLAS_BYTES, "atlas does not match WeatherIcon");
+
+static const uint8_t *atlas_pixels()
+{
+    return weather_icon_atlas;
+}
+#endif
+
+// Each icon is a contiguous slice of the atlas, so descriptors point straight into flash
+static bool bind_icons()
+{
+    const uint8_t *pixels = atlas_pixels();
+    if (!pixels)
+        return false;
+    for (int i = 0; i < WEATHER_ICON_COUNT; i++)
+    {
+        icons[i].header.always_zero = 0;
+        icons[i].header.cf = WEATHER_ICON_ATLAS_CF;
+        icons[i].header.w = ICON_SIZE;
+        icons[i].header.h = ICON_SIZE;
+        icons[i].data_size = ICON_BYTES;
+        icons[i].data = pixels + i * ICON_BYTES;
+    }
+    return true;
+}
+
+const lv_img_dsc_t *IconAtlas_Get(WeatherIcon icon)
+{
+    if (!icons[icon].data && !bind_icons())
+        return NULL;
+    return &icons[icon];
+}
+
+lv_obj_t *IconAtlas_Create(lv_obj_t *parent, WeatherIcon icon)
+{
+    lv_obj_t *img = lv_img_create(parent);
+    IconAtlas_Set(img, icon);
+    return img;
+}
+
+void IconAtlas_Set(lv_obj_t *img, WeatherIcon icon)
+{
+    lv_img_set_src(img, IconAtlas_Get(icon));
+#if WEATHER_ICON_FORMAT == 2
+    // LVGL draws alpha-only images in the recolour colour
+    lv_obj_set_style_img_recolor(img, lv_color_hex(weather_icon_tint[icon]), 0);
+#endif
+}
@@ -0,0 +1,75 @@
+#include <Arduino.h>
+#include "PanelFx.h"
+#include "Display.h"
+
+static lv_timer_t *flash_timer = NULL;
+static uint16_t flash_phases = 0; // Remaining invert/restore phases
+static bool inverted = false;
+
+static void flash_cb(lv_timer_t *timer)
+{
+    PanelFx_SetInverted(!inverted);
+    if (--flash_phases == 0)
+        PanelFx_Stop();
+}
+
+void PanelFx_Flash(uint16_t count, uint32_t period_ms)
+{
+    PanelFx_Stop();
+    if (count == 0)
+        return;
+
+    flash_phases = count * 2;
+    PanelFx_SetInverted(true);
+    flash_phases--;
+    flash_timer = lv_timer_create(flash_cb, period_ms, NULL);
+}
+
+void PanelFx_Stop()
+{
+    if (flash_timer)
+    {
+        lv_timer_del(flash_timer);
+        flash_timer = NULL;
+    }
+    flash_phases = 0;
+    PanelFx_SetInverted(false);
+}
+
+void PanelFx_SetInverted(bool on)
+{
+    if (on == inverted)
+        return;
+    inverted = on;
+    Display_Command((on != (bool)DISPLAY_INVERTED) ? ST7789_INVON : ST7789_INVOFF);
+}
+
+void PanelFx_SetBlanked(bool on)
+{
+    Display_Command(on ? ST7789_DISPOFF : ST7789_DISPON);
+}
+
+void PanelFx_SetPartial(int y1, int y2)
+{
+    int start = DISPLAY_GRAM_ROW_OFFSET + y1;
+    int end = DISPLAY_GRAM_ROW_OFFSET + y2;
+#if DISPLAY_ROTATION == 2
+    // MADCTL MY: logical rows run bottom-up through frame memory
+    int mirrored = DISPLAY_GRAM_ROWS - 1 - end;
+    end = DISPLAY_GRAM_ROWS - 1 - start;
+    start = mirrored;
+#endif
+    const uint8_t area[] = {(uint8_t)(start >> 8), (uint8_t)(start & 0xFF), (uint8_t)(end >> 8), (uint8_t)(end & 0xFF)};
+    Display_CommandData(ST7789_PTLAR, area, sizeof(area));
+    Display_Command(ST7789_PTLON);
+}
+
+void PanelFx_SetNormal()
+{
+    Display_Command(ST7789_NORON);
+}
+
+void PanelFx_SetIdle(bool on)
+{
+    Display_Command(on ? ST7789_IDMON : ST7789_IDMOFF);
+}
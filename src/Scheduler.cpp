@@ -0,0 +1,112 @@
+#include <Arduino.h>
+#include "Scheduler.h"
+
+// A handful of jobs: the earliest deadline is a linear scan, no heap or wheel needed
+struct Job
+{
+    SchedulerJob run;
+    uint32_t period_ms;
+    uint32_t due_ms;
+    bool armed; // due_ms is valid
+};
+
+static Job jobs[SCHEDULER_MAX_JOBS];
+static int job_count = 0;
+static SchedulerStats stats;
+static int running = -1;         // Job inside its run()
+static bool rescheduled = false; // ...which set its own next deadline
+static TaskHandle_t sleeper = NULL;
+
+// Wrap-safe: deadline reached at now
+static bool is_due(uint32_t due, uint32_t now)
+{
+    return (int32_t)(due - now) <= 0;
+}
+
+int Scheduler_Add(SchedulerJob job, uint32_t period_ms)
+{
+    if (job_count >= SCHEDULER_MAX_JOBS)
+        return -1;
+    Job *j = &jobs[job_count];
+    j->run = job;
+    j->period_ms = period_ms;
+    j->due_ms = millis() + period_ms;
+    j->armed = period_ms != SCHEDULER_OFF;
+    return job_count++;
+}
+
+void Scheduler_SetPeriod(int id, uint32_t period_ms)
+{
+    if (id < 0 || id >= job_count || jobs[id].period_ms == period_ms)
+        return;
+    jobs[id].period_ms = period_ms;
+    jobs[id].due_ms = millis() + period_ms;
+    jobs[id].armed = period_ms != SCHEDULER_OFF;
+    rescheduled |= id == running;
+}
+
+void Scheduler_In(int id, uint32_t delay_ms)
+{
+    if (id < 0 || id >= job_count)
+        return;
+    jobs[id].due_ms = millis() + delay_ms;
+    jobs[id].armed = delay_ms != SCHEDULER_OFF;
+    rescheduled |= id == running;
+}
+
+uint32_t Scheduler_RunDue()
+{
+    for (int i = 0; i < job_count; i++)
+    {
+        Job *j = &jobs[i];
+        if (!j->armed || !is_due(j->due_ms, millis()))
+            continue;
+        // Periodic by default; the job may override with Scheduler_In/SetPeriod while running
+        running = i;
+        rescheduled = false;
+        j->run();
+        running = -1;
+        stats.runs++;
+        if (!rescheduled)
+        {
+            j->armed = j->period_ms != SCHEDULER_OFF;
+            j->due_ms = millis() + j->period_ms;
+        }
+    }
+
+    uint32_t now = millis();
+    uint32_t next = SCHEDULER_OFF;
+    for (int i = 0; i < job_count; i++)
+    {
+        if (!jobs[i].armed)
+            continue;
+        uint32_t in = is_due(jobs[i].due_ms, now) ? 0 : jobs[i].due_ms - now;
+        next = min(next, in);
+    }
+    return next;
+}
+
+void Scheduler_Sleep(uint32_t ms)
+{
+    sleeper = xTaskGetCurrentTaskHandle();
+    // The notification count is the wake flag: a wake given before the take still counts
+    if (ms > 0 && ulTaskNotifyTake(pdTRUE, ms == SCHEDULER_OFF ? portMAX_DELAY : pdMS_TO_TICKS(ms)))
+        stats.early_wakeups++;
+    stats.wakeups++;
+}
+
+void Scheduler_Wake()
+{
+    if (sleeper)
+        xTaskNotifyGive(sleeper);
+}
+
+void Scheduler_GetStats(SchedulerStats *out)
+{
+    *out = stats;
+}
+
+void Scheduler_ResetStats()
+{
+    memset(&stats, 0, sizeof(stats));
+}
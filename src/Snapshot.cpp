@@ -0,0 +1,109 @@
+#include <Arduino.h>
+#include <esp_partition.h>
+#include "Snapshot.h"
+#include "Display.h"
+
+// Partition layout: header, then DISPLAY_WIDTH x DISPLAY_HEIGHT RGB565 pixels in LVGL
+// byte order. The header is written after the pixels, so an interrupted save leaves
+// erased flash where the magic should be and the frame is simply not shown.
+#define SNAPSHOT_SUBTYPE 0x40
+#define SNAPSHOT_MAGIC 0x50414E53 // "SNAP"
+#define SNAPSHOT_PIXELS_OFFSET 16
+
+struct SnapshotHeader
+{
+    uint32_t magic;
+    uint16_t width;
+    uint16_t height;
+    uint16_t swapped; // LV_COLOR_16_SWAP of the build that wrote it
+    uint16_t reserved[3];
+};
+
+static unsigned long shown_us = 0; // micros() when the stored frame was on the panel
+static unsigned long last_save_ms = 0;
+static bool saved = false;
+
+static const esp_partition_t *snapshot_partition()
+{
+    const esp_partition_t *part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                                           (esp_partition_subtype_t)SNAPSHOT_SUBTYPE, "snapshot");
+    if (part && part->size < SNAPSHOT_PIXELS_OFFSET + DISPLAY_WIDTH * DISPLAY_HEIGHT * 2)
+        return NULL;
+    return part;
+}
+
+bool Snapshot_Show()
+{
+#if WATCH_SNAPSHOT
+    const esp_partition_t *part = snapshot_partition();
+    if (!part)
+        return false;
+
+    // Map the partition so the frame goes from flash cache straight to the SPI bus
+    const void *map;
+    spi_flash_mmap_handle_t handle;
+    if (esp_partition_mmap(part, 0, part->size, SPI_FLASH_MMAP_DATA, &map, &handle) != ESP_OK)
+        return false;
+
+    const SnapshotHeader *header = (const SnapshotHeader *)map;
+    bool valid = header->magic == SNAPSHOT_MAGIC && header->width == DISPLAY_WIDTH &&
+                 header->height == DISPLAY_HEIGHT && header->swapped == LV_COLOR_16_SWAP;
+    if (valid)
+    {
+        Display_PushFrame((const uint16_t *)((const uint8_t *)map + SNAPSHOT_PIXELS_OFFSET));
+        shown_us = micros();
+    }
+    spi_flash_munmap(handle);
+    return valid;
+#else
+    return false;
+#endif
+}
+
+#if WATCH_SNAPSHOT
+static void snapshot_write_stripe(int y, int h, const uint16_t *pixels, void *ctx)
+{
+    const esp_partition_t *part = (const esp_partition_t *)ctx;
+    esp_partition_write(part, SNAPSHOT_PIXELS_OFFSET + y * DISPLAY_WIDTH * 2, pixels, h * DISPLAY_WIDTH * 2);
+}
+#endif
+
+void Snapshot_SaveIfDue()
+{
+#if WATCH_SNAPSHOT
+    if (saved && millis() - last_save_ms < WATCH_SNAPSHOT_INTERVAL_MIN * 60000UL)
+        return;
+    const esp_partition_t *part = snapshot_partition();
+    if (!part)
+        return;
+
+    uint32_t start = millis();
+    if (esp_partition_erase_range(part, 0, part->size) != ESP_OK)
+        return;
+    Display_Capture(snapshot_write_stripe, (void *)part);
+
+    SnapshotHeader header;
+    memset(&header, 0xFF, sizeof(header));
+    header.magic = SNAPSHOT_MAGIC;
+    header.width = DISPLAY_WIDTH;
+    header.height = DISPLAY_HEIGHT;
+    header.swapped = LV_COLOR_16_SWAP;
+    esp_partition_write(part, 0, &header, sizeof(header));
+
+    saved = true;
+    last_save_ms = millis();
+    Serial.printf("[boot] snapshot saved in %lu ms\n", (unsigned long)(millis() - start));
+#endif
+}
+
+void Snapshot_ReportBoot()
+{
+    unsigned long lvgl_us = Display_FirstFrameUs();
+    if (shown_us)
+        Serial.printf("[boot] first pixel: snapshot at %lu ms, LVGL frame at %lu ms\n", shown_us / 1000,
+                      lvgl_us / 1000);
+    else if (lvgl_us)
+        Serial.printf("[boot] first pixel: LVGL frame at %lu ms (no snapshot)\n", lvgl_us / 1000);
+    else
+        Serial.println("[boot] first pixel: LVGL has not rendered yet");
+}
@@ -0,0 +1,74 @@
+#include "Tasks.h"
+
+struct TaskInfo
+{
+    const char *name;
+    TaskHandle_t handle;
+    uint32_t stack_bytes;
+    int core; // -1 = not pinned
+    volatile uint32_t active_us; // Written by the task only
+    uint32_t reported_us;        // active_us at the last report
+};
+
+static TaskInfo tasks[TASKS_MAX];
+static volatile int task_count = 0;
+static uint32_t last_report_us = 0;
+
+static int add(const char *name, TaskHandle_t handle, uint32_t stack_bytes, int core)
+{
+    if (task_count >= TASKS_MAX)
+        return -1;
+    TaskInfo *t = &tasks[task_count];
+    t->name = name;
+    t->handle = handle;
+    t->stack_bytes = stack_bytes;
+    t->core = core;
+    t->active_us = 0;
+    t->reported_us = 0;
+    return task_count++;
+}
+
+// Registered before the task runs, so its first Tasks_AddActive has a slot to land in
+int Tasks_Start(const char *name, TaskFunction_t body, uint32_t stack_bytes, UBaseType_t priority, BaseType_t core)
+{
+    int id = add(name, NULL, stack_bytes, core);
+    if (id < 0)
+        return -1;
+    if (xTaskCreatePinnedToCore(body, name, stack_bytes, (void *)(intptr_t)id, priority, &tasks[id].handle, core) != pdPASS)
+    {
+        Serial.printf("[task] %s: not enough heap for a %lu B stack\n", name, (unsigned long)stack_bytes);
+        task_count--;
+        return -1;
+    }
+    return id;
+}
+
+int Tasks_Adopt(const char *name, uint32_t stack_bytes)
+{
+    return add(name, xTaskGetCurrentTaskHandle(), stack_bytes, xPortGetCoreID());
+}
+
+void Tasks_AddActive(int id, uint32_t us)
+{
+    if (id >= 0 && id < task_count)
+        tasks[id].active_us += us;
+}
+
+void Tasks_PrintStats()
+{
+    uint32_t now = micros();
+    uint32_t span = now - last_report_us;
+    last_report_us = now;
+    for (int i = 0; i < task_count; i++)
+    {
+        TaskInfo *t = &tasks[i];
+        uint32_t active = t->active_us - t->reported_us;
+        t->reported_us += active;
+        unsigned long permille = span ? (unsigned long)((uint64_t)active * 1000 / span) : 0;
+        // ESP-IDF counts the high-water mark in bytes (StackType_t is 8 bits)
+        unsigned long free_min = t->handle ? uxTaskGetStackHighWaterMark(t->handle) : 0;
+        Serial.printf("[task] %-7s core %d prio %u active %3lu.%lu%%  stack peak %5lu of %5lu B\n", t->name, t->core,
+                      t->handle ? (unsigned)uxTaskPriorityGet(t->handle) : 0, permille / 10, permille % 10,
+                      (unsigned long)t->stack_bytes - free_min, (unsigned long)t->stack_bytes);
+    }
+}
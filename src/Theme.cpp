@@ -0,0 +1,139 @@
+#include <Arduino.h>
+#include "Theme.h"
+#include "Fonts.h"
+
+static lv_style_t styles[THEME_COUNT];
+static bool ready = false;
+
+// Breakout rows, top to bottom (rainbow)
+static const uint32_t brick_colors[THEME_BRICK_ROWS] = {0xFF0000, 0xFF7F00, 0xFFFF00, 0x00FF00, 0x0000FF, 0x8B00FF};
+
+// Opaque filled rectangle; sprites have no theme styles under it, so border and padding stay 0
+static void init_fill(lv_style_t *style, uint32_t color, lv_coord_t radius)
+{
+    lv_style_init(style);
+    lv_style_set_bg_color(style, lv_color_hex(color));
+    lv_style_set_bg_opa(style, LV_OPA_COVER);
+    lv_style_set_radius(style, radius);
+}
+
+static void init_text(lv_style_t *style, const lv_font_t *font)
+{
+    lv_style_init(style);
+    lv_style_set_text_font(style, font);
+}
+
+void Theme_Init()
+{
+    if (ready)
+        return;
+    init_fill(&styles[THEME_HEADER], 0x1a1a2e, 0);
+
+    lv_style_init(&styles[THEME_FRAME]);
+    lv_style_set_bg_opa(&styles[THEME_FRAME], LV_OPA_COVER);
+    lv_style_set_border_width(&styles[THEME_FRAME], 2);
+
+    init_text(&styles[THEME_TITLE], WATCH_FONT_24);
+    init_text(&styles[THEME_TEXT], WATCH_FONT_14);
+    lv_style_set_text_color(&styles[THEME_TEXT], lv_color_hex(0xFFFFFF));
+    init_text(&styles[THEME_CAPTION], WATCH_FONT_14);
+    lv_style_set_text_color(&styles[THEME_CAPTION], lv_color_hex(0xCCCCCC));
+    init_text(&styles[THEME_STATUS], WATCH_FONT_14);
+    lv_style_set_text_align(&styles[THEME_STATUS], LV_TEXT_ALIGN_CENTER);
+
+    init_fill(&styles[THEME_SNAKE_CELL], 0x00ff41, 2);
+    init_fill(&styles[THEME_SNAKE_FOOD], 0xff0000, LV_RADIUS_CIRCLE);
+    init_fill(&styles[THEME_PADDLE], 0x00FFFF, 2);
+    init_fill(&styles[THEME_BALL], 0xFFFFFF, LV_RADIUS_CIRCLE);
+    for (int row = 0; row < THEME_BRICK_ROWS; row++)
+        init_fill(&styles[THEME_BRICK + row], brick_colors[row], 1);
+    ready = true;
+}
+
+void Theme_Apply(lv_obj_t *obj, int style)
+{
+    lv_obj_add_style(obj, &styles[style], 0);
+}
+
+lv_obj_t *Theme_CreateSprite(lv_obj_t *parent, int style)
+{
+    lv_obj_t *obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(obj); // The default theme's bg/border/pad/scrollbar styles would be resolved every frame
+    lv_obj_add_style(obj, &styles[style], 0);
+    return obj;
+}
+
+// --- Benchmark ---
+#if DISPLAY_BENCH
+#define BENCH_OBJS 48            // Kept small: the LVGL heap also holds every screen
+#define BENCH_SPRITES (160 + 48) // Snake cells + Breakout bricks
+#define BENCH_PASSES 20
+
+static uint32_t lv_heap_used()
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.total_size - mon.free_size;
+}
+
+// A snake cell as it used to be built: default theme + four local properties
+static lv_obj_t *bench_local_sprite(lv_obj_t *parent)
+{
+    lv_obj_t *obj = lv_obj_create(parent);
+    lv_obj_set_style_bg_color(obj, lv_color_hex(0x00ff41), 0);
+    lv_obj_set_style_border_width(obj, 0, 0);
+    lv_obj_set_style_radius(obj, 2, 0);
+    lv_obj_set_style_pad_all(obj, 0, 0);
+    return obj;
+}
+
+// What the renderer resolves for every visible object in every frame
+static uint32_t bench_resolve(lv_obj_t **objs)
+{
+    lv_draw_rect_dsc_t dsc;
+    uint32_t t0 = micros();
+    for (int p = 0; p < BENCH_PASSES; p++)
+    {
+        for (int i = 0; i < BENCH_OBJS; i++)
+        {
+            lv_draw_rect_dsc_init(&dsc);
+            lv_obj_init_draw_rect_dsc(objs[i], LV_PART_MAIN, &dsc);
+        }
+    }
+    return micros() - t0;
+}
+
+// Heap per object and resolve time for BENCH_SPRITES objects (scaled from BENCH_OBJS)
+static void bench_variant(bool shared, uint32_t *bytes, uint32_t *us)
+{
+    lv_obj_t *scr = lv_obj_create(NULL);
+    lv_obj_t *objs[BENCH_OBJS];
+    uint32_t before = lv_heap_used();
+    for (int i = 0; i < BENCH_OBJS; i++)
+        objs[i] = shared ? Theme_CreateSprite(scr, THEME_SNAKE_CELL) : bench_local_sprite(scr);
+    *bytes = (lv_heap_used() - before) / BENCH_OBJS;
+    *us = (uint64_t)bench_resolve(objs) * BENCH_SPRITES / (BENCH_OBJS * BENCH_PASSES);
+    lv_obj_del(scr);
+}
+#endif
+
+void Theme_RunBenchmark()
+{
+#if DISPLAY_BENCH
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    if (!mon.total_size)
+    {
+        Serial.println("[bench] theme: LVGL heap not monitored (LV_MEM_CUSTOM)");
+        return;
+    }
+    uint32_t local_b, local_us, shared_b, shared_us;
+    bench_variant(false, &local_b, &local_us);
+    bench_variant(true, &shared_b, &shared_us);
+    Serial.printf("[bench] theme local  %4lu B/obj  resolve %5lu us/frame for %d sprites\n",
+                  (unsigned long)local_b, (unsigned long)local_us, BENCH_SPRITES);
+    Serial.printf("[bench] theme shared %4lu B/obj  resolve %5lu us/frame  -> %ld B LVGL heap saved\n",
+                  (unsigned long)shared_b, (unsigned long)shared_us,
+                  ((long)local_b - (long)shared_b) * BENCH_SPRITES);
+#endif
+}
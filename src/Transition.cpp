@@ -0,0 +1,114 @@
+#include <Arduino.h>
+#include "Transition.h"
+#include "Display.h"
+
+#if DISPLAY_HW_SCROLL
+// The incoming screen is written into the frame memory just beyond the visible
+// window and the ST7789 scroll start address walks onto it. Each step only renders
+// and pushes the strip that has just become visible; the outgoing screen is never
+// redrawn.
+static lv_timer_t *step_timer = NULL;
+static uint32_t start_tick = 0;
+static int old_base = 0;  // Row base of the outgoing screen
+static int direction = 1; // +1 = new screen enters from the bottom, -1 = from the top
+static int exposed = 0;   // Rows of the new screen already visible
+
+// Ease-out cubic: rows of the new screen visible after `elapsed` ms
+static int transition_rows(uint32_t elapsed)
+{
+    if (elapsed >= TRANSITION_TIME)
+        return DISPLAY_HEIGHT;
+    int64_t left = TRANSITION_TIME - elapsed;
+    int64_t total = (int64_t)TRANSITION_TIME * TRANSITION_TIME * TRANSITION_TIME;
+    return DISPLAY_HEIGHT - (int)(left * left * left * DISPLAY_HEIGHT / total);
+}
+
+static void transition_finish()
+{
+    lv_timer_del(step_timer);
+    step_timer = NULL;
+
+    // Anything that changed outside the exposed strips during the slide is redrawn now
+    lv_area_t dropped;
+    if (Display_EndRowClip(&dropped))
+        lv_obj_invalidate_area(lv_scr_act(), &dropped);
+}
+
+// lv_scr_load invalidated the whole new screen; the steps draw all of it strip by strip
+// instead, so every pending area is dropped (the outgoing screen was settled just before).
+// Without access to the list LVGL renders the screen once more, the row clip keeps that
+// off the panel, and transition_finish redraws it in place.
+static void drop_pending_areas()
+{
+#if DISPLAY_LVGL_AREA_LIST
+    lv_disp_get_default()->inv_p = 0;
+#endif
+}
+
+static void transition_step(lv_timer_t *timer)
+{
+    int rows = transition_rows(lv_tick_elaps(start_tick));
+    if (rows > exposed)
+    {
+        lv_area_t strip;
+        if (direction > 0)
+        {
+            lv_area_set(&strip, 0, exposed, DISPLAY_WIDTH - 1, rows - 1);
+            Display_SetRowClip(0, rows - 1);
+        }
+        else
+        {
+            lv_area_set(&strip, 0, DISPLAY_HEIGHT - rows, DISPLAY_WIDTH - 1, DISPLAY_HEIGHT - exposed - 1);
+            Display_SetRowClip(DISPLAY_HEIGHT - rows, DISPLAY_HEIGHT - 1);
+        }
+        lv_obj_invalidate_area(lv_scr_act(), &strip);
+        lv_refr_now(NULL);
+
+        // Strip is in frame memory: move the window onto it
+        Display_SetScrollOffset(old_base + direction * rows);
+        exposed = rows;
+    }
+
+    if (exposed >= DISPLAY_HEIGHT)
+        transition_finish();
+}
+#endif
+
+void Transition_Load(lv_obj_t *scr, lv_scr_load_anim_t anim)
+{
+#if DISPLAY_HW_SCROLL
+    if (step_timer)
+    {
+        // Complete the running slide before starting the next one
+        start_tick = lv_tick_get() - TRANSITION_TIME;
+        transition_step(step_timer);
+    }
+    if (scr == lv_scr_act())
+        return;
+
+    direction = (anim == LV_SCR_LOAD_ANIM_MOVE_RIGHT || anim == LV_SCR_LOAD_ANIM_OVER_RIGHT) ? -1 : 1;
+
+    // Settle the outgoing screen, then switch without redrawing it all
+    lv_refr_now(NULL);
+    old_base = Display_GetRowBase();
+    lv_scr_load(scr);
+    drop_pending_areas();
+
+    Display_SetRowBase(old_base + direction * DISPLAY_HEIGHT);
+    Display_SetRowClip(0, -1); // Nothing of the new screen is visible yet
+    exposed = 0;
+    start_tick = lv_tick_get();
+    step_timer = lv_timer_create(transition_step, 10, NULL);
+#else
+    lv_scr_load_anim(scr, anim, TRANSITION_TIME, 0, false);
+#endif
+}
+
+bool Transition_IsRunning()
+{
+#if DISPLAY_HW_SCROLL
+    return step_timer != NULL;
+#else
+    return false;
+#endif
+}
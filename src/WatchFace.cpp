@@ -0,0 +1,218 @@
+#include <Arduino.h>
+#include <Preferences.h>
+#include <esp32/rom/tjpgd.h>
+#include "WatchFace.h"
+#include "Background.h"
+#include "AssetStore.h"
+#include "Display.h"
+
+#define FACE_W DISPLAY_WIDTH
+#define FACE_H DISPLAY_HEIGHT
+#define FACE_PREFIX "face_" // Asset names written by tools/asset_pipeline.py
+#define FACE_PREFIX_LEN 5
+#define JPEG_POOL_BYTES 3100 // TJpgDec work area, freed after each decode
+
+static const lv_img_dsc_t *faces[WATCH_FACE_MAX]; // JPEG file bytes; [0] is the photo
+static const char *face_names[WATCH_FACE_MAX] = {"photo"};
+static int face_count = 1;
+static int current = 0;
+
+// The one resident copy of a JPEG face; freed again when the photo is selected
+static lv_color_t *cache = NULL;
+static lv_img_dsc_t cache_dsc = {{LV_IMG_CF_TRUE_COLOR, 0, 0, FACE_W, FACE_H}, FACE_W * FACE_H * sizeof(lv_color_t), NULL};
+
+static Preferences prefs;
+
+// --- JPEG Decode ---
+// The ESP32 ROM carries TJpgDec: baseline only, RGB888 out, one MCU (8x8 up to 16x16)
+// per callback. Each block is converted straight into its place in the cache, so
+// nothing but the work pool exists besides the final image.
+struct JpegJob
+{
+    const uint8_t *src;
+    uint32_t size;
+    uint32_t pos;
+    lv_color_t *out;
+};
+
+static UINT jpeg_in(JDEC *jd, BYTE *buf, UINT len)
+{
+    JpegJob *job = (JpegJob *)jd->device;
+    len = min(len, (UINT)(job->size - job->pos));
+    if (buf) // NULL = skip
+        memcpy(buf, job->src + job->pos, len);
+    job->pos += len;
+    return len;
+}
+
+static UINT jpeg_out(JDEC *jd, void *bitmap, JRECT *rect)
+{
+    JpegJob *job = (JpegJob *)jd->device;
+    const BYTE *rgb = (const BYTE *)bitmap;
+    for (int y = rect->top; y <= rect->bottom; y++)
+    {
+        lv_color_t *row = job->out + y * FACE_W;
+        for (int x = rect->left; x <= rect->right; x++, rgb += 3)
+            row[x] = lv_color_make(rgb[0], rgb[1], rgb[2]);
+    }
+    return 1;
+}
+
+// Decode face into the cache. The header is checked before the cache is touched; peak is
+// the heap held by faces while decoding (cache + pool)
+static bool decode_face(int face, uint32_t *us, uint32_t *peak)
+{
+    uint32_t held = cache ? cache_dsc.data_size : 0;
+    uint32_t free_before = ESP.getFreeHeap();
+    uint32_t t0 = micros();
+    void *pool = malloc(JPEG_POOL_BYTES);
+    if (!pool)
+        return false;
+
+    JDEC jd;
+    JpegJob job = {faces[face]->data, faces[face]->data_size, 0, NULL};
+    JRESULT res = jd_prepare(&jd, jpeg_in, pool, JPEG_POOL_BYTES, &job);
+    if (res == JDR_OK && (jd.width != FACE_W || jd.height != FACE_H))
+        res = JDR_FMT1;
+    if (res == JDR_OK && !cache)
+    {
+        cache = (lv_color_t *)heap_caps_malloc(cache_dsc.data_size, MALLOC_CAP_8BIT);
+        cache_dsc.data = (const uint8_t *)cache;
+        if (!cache)
+            res = JDR_MEM1;
+    }
+    if (res == JDR_OK)
+    {
+        *peak = held + free_before - ESP.getFreeHeap();
+        job.out = cache;
+        res = jd_decomp(&jd, jpeg_out, 0);
+    }
+    free(pool);
+    *us = micros() - t0;
+
+    if (res != JDR_OK)
+        Serial.printf("WatchFace: %s: JPEG error %d\n", face_names[face], res);
+    return res == JDR_OK;
+}
+
+static void show_photo()
+{
+    Background_SetFace(NULL);
+    free(cache);
+    cache = NULL;
+    cache_dsc.data = NULL;
+    current = 0;
+}
+
+static bool show_face(int face)
+{
+    if (face == 0)
+    {
+        show_photo();
+        return true;
+    }
+    uint32_t us, peak = 0;
+    if (!decode_face(face, &us, &peak))
+    {
+        show_photo(); // A failed decode may have left half a face in the cache
+        return false;
+    }
+    Background_SetFace(&cache_dsc);
+    current = face;
+    Serial.printf("WatchFace: %s decoded in %lu us (%lu B JPEG), peak heap %lu B, free %lu B\n", face_names[face],
+                  (unsigned long)us, (unsigned long)faces[face]->data_size, (unsigned long)peak,
+                  (unsigned long)ESP.getFreeHeap());
+    return true;
+}
+
+// --- Public API ---
+void WatchFace_Init()
+{
+#if WATCH_FACES && WATCH_ASSET_STORE && FACE_W * FACE_H * 2 <= WATCH_FACE_CACHE_MAX
+    if (!AssetStore_Mount())
+        return;
+    const lv_img_dsc_t *img;
+    const char *name;
+    for (int i = 0; face_count < WATCH_FACE_MAX && (img = AssetStore_At(i, &name)); i++)
+    {
+        if (img->header.cf != LV_IMG_CF_RAW || strncmp(name, FACE_PREFIX, FACE_PREFIX_LEN) != 0)
+            continue;
+        faces[face_count] = img;
+        face_names[face_count++] = name + FACE_PREFIX_LEN;
+    }
+
+    char saved[16] = "";
+    prefs.begin("watchface", true);
+    if (prefs.isKey("face"))
+        prefs.getString("face", saved, sizeof(saved));
+    prefs.end();
+    for (int f = 1; f < face_count; f++)
+        if (strcmp(face_names[f], saved) == 0)
+        {
+            show_face(f);
+            break;
+        }
+    Serial.printf("WatchFace: %d faces, showing %s\n", face_count, face_names[current]);
+#endif
+}
+
+int WatchFace_Count()
+{
+    return face_count;
+}
+
+int WatchFace_Current()
+{
+    return current;
+}
+
+const char *WatchFace_Name(int face)
+{
+    return face >= 0 && face < face_count ? face_names[face] : NULL;
+}
+
+bool WatchFace_Select(int face)
+{
+    if (face < 0 || face >= face_count)
+        return false;
+    if (face == current)
+        return true;
+    bool ok = show_face(face);
+    prefs.begin("watchface", false);
+    prefs.putString("face", face_names[current]);
+    prefs.end();
+    return ok;
+}
+
+bool WatchFace_Step(int delta)
+{
+    return WatchFace_Select(((current + delta) % face_count + face_count) % face_count);
+}
+
+// --- Benchmark ---
+#define BENCH_PASSES 5
+
+void WatchFace_RunBenchmark()
+{
+#if DISPLAY_BENCH
+    int shown = current;
+    for (int f = 1; f < face_count; f++)
+    {
+        uint32_t first_us, us, peak = 0, total_us = 0;
+        bool ok = decode_face(f, &first_us, &peak); // Cold flash cache
+        for (int i = 0; ok && i < BENCH_PASSES; i++)
+        {
+            ok = decode_face(f, &us, &peak);
+            total_us += us;
+        }
+        if (!ok)
+            continue;
+        Serial.printf("[bench] face %-8s %5lu B JPEG  decode first %6lu avg %6lu us  peak heap %6lu B\n",
+                      face_names[f], (unsigned long)faces[f]->data_size, (unsigned long)first_us,
+                      (unsigned long)(total_us / BENCH_PASSES), (unsigned long)peak);
+    }
+    show_face(shown); // The cache only stays if a JPEG face is on screen
+    Serial.printf("[bench] face heap: free %lu B, lowest since boot %lu B\n", (unsigned long)ESP.getFreeHeap(),
+                  (unsigned long)ESP.getMinFreeHeap());
+#endif
+}
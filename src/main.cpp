@@ -1,25 +1,33 @@
 
 #include <Arduino.h>
 #include <lvgl.h>
-#include <TFT_eSPI.h>
 #include <WiFi.h>
 #include <time.h>
+#include <sys/time.h>
 
-#include "bg_image.h"
+#include "Display.h"
+#include "Background.h"
+#include "WatchFace.h"
+#include "Fonts.h"
+#include "DigitSprite.h"
+#include "Theme.h"
+#include "Transition.h"
+#include "DrawSwar.h"
 #include "AppWeather.h"
 #include "AppTimer.h"
 #include "AppSnake.h"
 #include "AppBreakout.h"
-
-LV_FONT_DECLARE(lv_font_montserrat_14);
-LV_FONT_DECLARE(lv_font_montserrat_24);
-LV_FONT_DECLARE(lv_font_montserrat_48);
+#include "AppAlwaysOn.h"
+#include "Snapshot.h"
+#include "Scheduler.h"
+#include "Tasks.h"
 
 lv_obj_t *home_screen; // Variable to store your Clock screen
 bool onWeatherPage = false;
 bool onTimerPage = false;
 bool onSnakePage = false;
 bool onBreakoutPage = false;
+unsigned long lastActivity = 0; // Last button press, for the always-on timeout
 
 // --- Hardware Pins (Gamepad Setup) ---
 #define BUTTON_PIN 34 // Analog pin for all buttons
@@ -56,28 +64,60 @@ enum Button
 };
 
 // ========== BUZZER FUNCTIONS ==========
+// With WATCH_TASKS the patterns are queued and played by the input task, so a beep no longer
+// holds up rendering; until the tasks start (boot) they play inline.
+struct Sound
+{
+  uint8_t count;  // Beeps per group
+  uint8_t groups;
+  uint16_t on_ms, off_ms, gap_ms; // Beep, pause between beeps, pause after each group
+};
+
+static QueueHandle_t sound_queue = NULL;
+
+static void play(const Sound *s)
+{
+  for (int g = 0; g < s->groups; g++)
+  {
+    for (int i = 0; i < s->count; i++)
+    {
+      digitalWrite(BUZZER_PIN, HIGH);
+      delay(s->on_ms);
+      digitalWrite(BUZZER_PIN, LOW);
+      if (i < s->count - 1)
+        delay(s->off_ms);
+    }
+    delay(s->gap_ms);
+  }
+}
+
+static void sound(uint8_t count, uint16_t on_ms, uint16_t off_ms, uint8_t groups = 1, uint16_t gap_ms = 0)
+{
+  Sound s = {count, groups, on_ms, off_ms, gap_ms};
+  if (sound_queue)
+    xQueueSend(sound_queue, &s, 0); // Dropped if the queue is full
+  else
+    play(&s);
+}
+
 void beep(int duration_ms = 100)
 {
-  digitalWrite(BUZZER_PIN, HIGH);
-  delay(duration_ms);
-  digitalWrite(BUZZER_PIN, LOW);
+  sound(1, duration_ms, 0);
 }
 
 void beepPattern(int count, int duration = 50, int pause = 50)
 {
-  for (int i = 0; i < count; i++)
-  {
-    digitalWrite(BUZZER_PIN, HIGH);
-    delay(duration);
-    digitalWrite(BUZZER_PIN, LOW);
-    if (i < count - 1)
-      delay(pause);
-  }
+  sound(count, duration, pause);
 }
 
 void timerAlarmSound()
 {
   // Loud repeating alarm pattern
+  if (sound_queue)
+  {
+    sound(3, 100, 50, 10, 300); // 10 x 3 quick beeps on the input task; the screen keeps running
+    return;
+  }
   for (int i = 0; i < 10; i++)
   {
     beepPattern(3, 100, 50); // 3 quick beeps
@@ -86,6 +126,69 @@ void timerAlarmSound()
   }
 }
 
+// ========== PER-APP REFRESH ==========
+// Each page declares how often LVGL needs to look for changes; the loop applies it
+// for whichever page is shown and accounts the time it spends busy on that page.
+#define WATCH_HOME_REFRESH_MS 1000 // HH:MM face
+
+enum WatchApp
+{
+  APP_HOME,
+  APP_WEATHER,
+  APP_TIMER,
+  APP_SNAKE,
+  APP_BREAKOUT,
+  APP_COUNT
+};
+
+struct AppProfile
+{
+  const char *name;
+  uint32_t refresh_ms;
+  unsigned long busy_us;  // Loop time spent working while this app was shown
+  unsigned long total_us; // Loop time including the idle delay
+  unsigned long wakeups;  // Loop passes
+};
+
+static AppProfile app_profiles[APP_COUNT] = {
+    {"home", WATCH_HOME_REFRESH_MS, 0, 0, 0},
+    {"weather", APP_WEATHER_REFRESH_MS, 0, 0, 0},
+    {"timer", APP_TIMER_REFRESH_MS, 0, 0, 0},
+    {"snake", APP_SNAKE_REFRESH_MS, 0, 0, 0},
+    {"breakout", APP_BREAKOUT_REFRESH_MS, 0, 0, 0},
+};
+
+WatchApp currentApp()
+{
+  if (onSnakePage)
+    return APP_SNAKE;
+  if (onBreakoutPage)
+    return APP_BREAKOUT;
+  if (onWeatherPage)
+    return APP_WEATHER;
+  if (onTimerPage)
+    return APP_TIMER;
+  return APP_HOME;
+}
+
+void printAppCpu()
+{
+  for (int i = 0; i < APP_COUNT; i++)
+  {
+    AppProfile *app = &app_profiles[i];
+    if (app->total_us == 0)
+      continue;
+    unsigned long idle_permille = 1000 - (unsigned long)((uint64_t)app->busy_us * 1000 / app->total_us);
+    unsigned long wake_x10 = (unsigned long)((uint64_t)app->wakeups * 10000000ULL / app->total_us);
+    Serial.printf("[cpu] %-8s refresh=%lums idle=%lu.%lu%% wakeups=%lu.%lu/s busy=%lums of %lums\n", app->name,
+                  (unsigned long)app->refresh_ms, idle_permille / 10, idle_permille % 10, wake_x10 / 10,
+                  wake_x10 % 10, app->busy_us / 1000, app->total_us / 1000);
+    app->busy_us = 0;
+    app->total_us = 0;
+    app->wakeups = 0;
+  }
+}
+
 // ========== BUTTON READING ==========
 Button readButton()
 {
@@ -110,116 +213,752 @@ Button readButton()
   return BTN_NONE;
 }
 // --- Global Objects ---
-TFT_eSPI tft = TFT_eSPI();
-static lv_disp_draw_buf_t draw_buf;
-static lv_color_t buf[135 * 40]; // Larger buffer for smoother image loading
 static lv_obj_t *time_label;
 static lv_obj_t *date_label;
 
-// --- WiFi Credentials ---
-const char *ssid = "Redmi 9 Power";
-const char *pass = "890890890";
+// --- Glass Tile Cache ---
+// Static background + translucent glass composite, blended once into SRAM so that
+// clock/date redraws only copy the tile and rasterize glyphs. 0 = let LVGL blend every tick.
+#ifndef WATCH_GLASS_TILE
+#define WATCH_GLASS_TILE 1
+#endif
+
+#define GLASS_W (DISPLAY_WIDTH * 8 / 9) // 120 x 80 on 135x240
+#define GLASS_H (DISPLAY_HEIGHT / 3)
+#define GLASS_Y (DISPLAY_HEIGHT / 12)
+#define GLASS_RADIUS (GLASS_H / 8)
+#define GLASS_OPA LV_OPA_40
 
-// --- LVGL Display Flush Function ---
-void my_disp_flush(lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t *color_p)
+#if WATCH_GLASS_TILE
+static lv_color_t glass_tile[GLASS_W * GLASS_H];
+static lv_img_dsc_t glass_tile_dsc;
+static lv_area_t glass_area;
+
+// Coverage of the rounded glass rectangle at a tile pixel (0..255, anti-aliased at the corners)
+static uint8_t glass_coverage(int x, int y)
 {
-  uint32_t w = (area->x2 - area->x1 + 1);
-  uint32_t h = (area->y2 - area->y1 + 1);
-  tft.startWrite();
-  tft.setAddrWindow(area->x1, area->y1, w, h);
-  tft.pushColors((uint16_t *)&color_p->full, w * h, true);
-  tft.endWrite();
-  lv_disp_flush_ready(disp);
+  float px = x + 0.5f;
+  float py = y + 0.5f;
+  float dx = max(max(GLASS_RADIUS - px, px - (GLASS_W - GLASS_RADIUS)), 0.0f);
+  float dy = max(max(GLASS_RADIUS - py, py - (GLASS_H - GLASS_RADIUS)), 0.0f);
+  float cov = GLASS_RADIUS + 0.5f - sqrtf(dx * dx + dy * dy);
+  if (cov <= 0)
+    return 0;
+  if (cov >= 1)
+    return 255;
+  return (uint8_t)(cov * 255);
+}
+
+// Blend the glass over the background region it covers, exactly once
+static void build_glass_tile(const lv_area_t *area)
+{
+  lv_color_t black = lv_color_hex(0x000000);
+  lv_color_t src[GLASS_W];
+
+  for (int y = 0; y < GLASS_H; y++)
+  {
+    Background_ReadRow(area->y1 + y, area->x1, GLASS_W, src);
+    for (int x = 0; x < GLASS_W; x++)
+    {
+      lv_color_t px = src[x];
+      uint8_t opa = (GLASS_OPA * glass_coverage(x, y)) / 255;
+      glass_tile[y * GLASS_W + x] = opa ? lv_color_mix(black, px, opa) : px;
+    }
+  }
+
+  glass_tile_dsc.header.always_zero = 0;
+  glass_tile_dsc.header.cf = LV_IMG_CF_TRUE_COLOR; // Opaque: LVGL starts drawing here, skipping the flash background
+  glass_tile_dsc.header.w = GLASS_W;
+  glass_tile_dsc.header.h = GLASS_H;
+  glass_tile_dsc.data = (const uint8_t *)glass_tile;
+  glass_tile_dsc.data_size = sizeof(glass_tile);
 }
+#endif
+
+// --- WiFi Credentials ---
+const char *ssid = "Redmi 9 Power";
+const char *pass = "890890890";
 
 // --- UI Creation ---
 void create_watch_face()
 {
   lv_obj_t *scr = lv_scr_act();
 
-  // 1. Draw Background Image (adam.jpg)
-  static lv_img_dsc_t img_dsc;
-  img_dsc.header.always_zero = 0;
-  img_dsc.header.cf = LV_IMG_CF_TRUE_COLOR; // RGB565
-  img_dsc.header.w = 135;
-  img_dsc.header.h = 240;
-  img_dsc.data = (const uint8_t *)my_image_map;
-  img_dsc.data_size = 64800;
-
-  lv_obj_t *bg = lv_img_create(scr);
-  lv_img_set_src(bg, &img_dsc);
+  // 1. Draw Background Image (adam.jpg) - BG_FORMAT_RAW / _Q565 / _INDEXED8
+  lv_obj_t *bg = Background_Create(scr, WATCH_BG_FORMAT);
   lv_obj_align(bg, LV_ALIGN_CENTER, 0, 0);
 
   // 2. Create Glass-Morphism Overlay (Makes text readable)
   lv_obj_t *glass = lv_obj_create(scr);
-  lv_obj_set_size(glass, 120, 80);
-  lv_obj_align(glass, LV_ALIGN_TOP_MID, 0, 20);
-  lv_obj_set_style_bg_opa(glass, LV_OPA_40, 0); // Transparent
-  lv_obj_set_style_bg_color(glass, lv_color_hex(0x000000), 0);
+  lv_obj_set_size(glass, GLASS_W, GLASS_H);
+  lv_obj_align(glass, LV_ALIGN_TOP_MID, 0, GLASS_Y);
   lv_obj_set_style_border_width(glass, 0, 0);
-  lv_obj_set_style_radius(glass, 10, 0);
+#if WATCH_GLASS_TILE
+  // Pre-blended tile sits under the (now fully transparent) glass container
+  lv_obj_update_layout(glass);
+  lv_obj_get_coords(glass, &glass_area);
+  build_glass_tile(&glass_area);
+
+  lv_obj_t *tile = lv_img_create(scr);
+  lv_img_set_src(tile, &glass_tile_dsc);
+  lv_obj_set_pos(tile, glass_area.x1, glass_area.y1);
+  lv_obj_move_foreground(glass);
+  lv_obj_set_style_bg_opa(glass, LV_OPA_TRANSP, 0);
+#else
+  lv_obj_set_style_bg_opa(glass, GLASS_OPA, 0); // Transparent
+  lv_obj_set_style_bg_color(glass, lv_color_hex(0x000000), 0);
+  lv_obj_set_style_radius(glass, GLASS_RADIUS, 0);
+#endif
 
   // 3. Time Label
-  time_label = lv_label_create(glass);
-  lv_obj_set_style_text_font(time_label, &lv_font_montserrat_24, 0);
-  lv_obj_set_style_text_color(time_label, lv_color_hex(0xFFFFFF), 0);
+  time_label = DigitSprite_Create(glass, WATCH_FONT_24, "00:00");
+  DigitSprite_SetColor(time_label, lv_color_hex(0xFFFFFF));
   lv_obj_align(time_label, LV_ALIGN_TOP_MID, 0, 5);
-  lv_label_set_text(time_label, "00:00");
 
   // 4. Date Label
   date_label = lv_label_create(glass);
-  lv_obj_set_style_text_font(date_label, &lv_font_montserrat_14, 0);
-  lv_obj_set_style_text_color(date_label, lv_color_hex(0xCCCCCC), 0);
+  Theme_Apply(date_label, THEME_CAPTION);
   lv_obj_align(date_label, LV_ALIGN_BOTTOM_MID, 0, -10);
   lv_label_set_text(date_label, "Loading...");
 }
 
+// --- Minute Flip ---
+// The next minute's glass area is rendered into RAM shortly before the boundary and sent
+// in one write when the minute changes, so no rendering sits between the tick and the panel.
+// 0 = update_time() redraws the labels after it has seen the new minute.
+#ifndef WATCH_CLOCK_PRERENDER
+#define WATCH_CLOCK_PRERENDER 1
+#endif
+#define CLOCK_LEAD_MS 500 // Render this long before the minute changes
+#define CLOCK_SPIN_MS 15  // Busy-wait the last stretch instead of waiting for the next loop
+
+#if WATCH_CLOCK_PRERENDER
+static uint16_t *next_minute_px = NULL; // Glass area showing next_minute, 19.2 KB while armed
+static lv_area_t next_minute_area;
+static time_t next_minute = 0;
+#endif
+
+static void show_time(const struct tm *timeinfo)
+{
+  char buf_time[10];
+  strftime(buf_time, sizeof(buf_time), "%H:%M", timeinfo);
+  DigitSprite_SetText(time_label, buf_time); // Once a minute this redraws one or two digit cells
+
+  char buf_date[20];
+  strftime(buf_date, sizeof(buf_date), "%a, %d %b", timeinfo);
+  lv_label_set_text(date_label, buf_date);
+}
+
 void update_time()
 {
+#if WATCH_CLOCK_PRERENDER
+  if (next_minute_px)
+    return; // Labels already hold the next minute
+#endif
   struct tm timeinfo;
-  if (!getLocalTime(&timeinfo))
+  if (!getLocalTime(&timeinfo, 0)) // Not synced yet: do not wait for NTP here
     return;
+  show_time(&timeinfo);
+}
 
-  char buf_time[10];
-  strftime(buf_time, sizeof(buf_time), "%H:%M", &timeinfo);
-  lv_label_set_text(time_label, buf_time);
+#if WATCH_CLOCK_PRERENDER
+// Milliseconds until the next minute starts; *boundary = its epoch second
+static long ms_to_minute(time_t *boundary)
+{
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  *boundary = tv.tv_sec - tv.tv_sec % 60 + 60; // The UTC offset is whole minutes
+  return (long)(*boundary - tv.tv_sec) * 1000 - tv.tv_usec / 1000;
+}
 
-  char buf_date[20];
-  strftime(buf_date, sizeof(buf_date), "%a, %d %b", &timeinfo);
-  lv_label_set_text(date_label, buf_date);
+static void drop_next_minute()
+{
+  free(next_minute_px);
+  next_minute_px = NULL;
+}
+
+// The glass area is about to change or leave the panel under an armed pre-render: the
+// pixels are stale, and the labels go back to the current minute until it is re-armed
+static void cancel_next_minute()
+{
+  if (!next_minute_px)
+    return;
+  drop_next_minute();
+  update_time();
+}
+
+// Arm the pre-render inside the lead window, flip on the boundary (call from loop)
+static void clock_flip()
+{
+  time_t boundary;
+  long ms = ms_to_minute(&boundary);
+
+  if (!next_minute_px)
+  {
+    struct tm next;
+    if (ms > CLOCK_LEAD_MS || boundary < 1000000000L || lv_scr_act() != home_screen || Transition_IsRunning())
+      return; // Not due, clock not synced yet, or home not on the panel
+    lv_obj_get_coords(lv_obj_get_parent(time_label), &next_minute_area);
+    next_minute_px = (uint16_t *)malloc(lv_area_get_size(&next_minute_area) * 2);
+    if (!next_minute_px)
+      return; // update_time() draws this minute the old way
+
+#if DISPLAY_STATS
+    uint32_t t0 = micros();
+#endif
+    lv_refr_now(NULL); // Anything else pending still goes out with the current minute
+    localtime_r(&boundary, &next);
+    show_time(&next);
+    Display_RenderArea(&next_minute_area, next_minute_px);
+    next_minute = boundary;
+#if DISPLAY_STATS
+    Serial.printf("[clock] next minute rendered in %lu us, %ld ms ahead\n", (unsigned long)(micros() - t0), ms);
+#endif
+    return;
+  }
+
+  if (lv_scr_act() != home_screen || Transition_IsRunning())
+  {
+    cancel_next_minute(); // Home is redrawn from the labels when it comes back
+    return;
+  }
+  if (boundary <= next_minute && ms > CLOCK_SPIN_MS)
+    return;
+  while (boundary <= next_minute)
+    ms = ms_to_minute(&boundary);
+
+#if DISPLAY_STATS
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+#endif
+  Display_PushArea(&next_minute_area, next_minute_px);
+  drop_next_minute();
+#if DISPLAY_STATS
+  struct timeval done;
+  gettimeofday(&done, NULL);
+  Serial.printf("[clock] flip %ld us after the minute, on the panel %ld us later\n",
+                (long)(tv.tv_sec - next_minute) * 1000000L + tv.tv_usec,
+                (long)(done.tv_sec - tv.tv_sec) * 1000000L + done.tv_usec - tv.tv_usec);
+#endif
+}
+
+// Milliseconds until clock_flip() has work: the lead window, then the spin before the flip
+static uint32_t clock_flip_due_ms()
+{
+  time_t boundary;
+  long ms = ms_to_minute(&boundary);
+  if (next_minute_px)
+    ms = boundary > next_minute ? 0 : ms - CLOCK_SPIN_MS;
+  else if (ms > CLOCK_LEAD_MS)
+    ms -= CLOCK_LEAD_MS; // Inside the window but not armed (home hidden): wake on the minute
+  return constrain(ms, 0L, 1000L);
+}
+#endif
+
+// The glass tile holds the background it was blended over; redo it for a new face.
+// The background image invalidates the whole screen, tile included.
+void change_face(int delta)
+{
+#if WATCH_CLOCK_PRERENDER
+  cancel_next_minute(); // Rendered over the old face
+#endif
+  WatchFace_Step(delta);
+#if WATCH_GLASS_TILE
+  build_glass_tile(&glass_area);
+#endif
+}
+
+// ========== BUTTON HANDLING ==========
+// Edge + debounce on one ladder sample: the newly pressed button, else BTN_NONE
+static Button take_press(Button current_button)
+{
+  static Button last_button = BTN_NONE;
+  static unsigned long last_press = 0;
+
+  Button pressed = BTN_NONE;
+  if (current_button != last_button && millis() - last_press > 100)
+  {
+    last_press = millis();
+    pressed = current_button;
+    last_button = current_button;
+  }
+  return pressed;
+}
+
+// Navigation and app input for one press
+static void handle_press(Button current_button)
+{
+  lastActivity = millis();
+  beep(20);
+  Display_RefreshSoon(); // Show the reaction now, not at the next slow-page refresh
+
+  // ========== SNAKE PAGE HANDLING ==========
+  if (onSnakePage)
+  {
+    bool playing = AppSnake_IsPlaying();
+    bool in_menu = AppSnake_IsInMenu();
+
+    if (playing)
+    {
+      // ===== PLAYING: Arrow keys control snake =====
+      if (current_button == BTN_UP)
+      {
+        AppSnake_SetDirection(0);
+      }
+      else if (current_button == BTN_DOWN)
+      {
+        AppSnake_SetDirection(2);
+      }
+      else if (current_button == BTN_LEFT)
+      {
+        AppSnake_SetDirection(3);
+      }
+      else if (current_button == BTN_RIGHT)
+      {
+        AppSnake_SetDirection(1);
+      }
+    }
+    else if (in_menu)
+    {
+      // ===== MENU: CENTER starts, LEFT/RIGHT navigate =====
+      if (current_button == BTN_CENTER)
+      {
+        AppSnake_Start();
+        beep(40);
+      }
+      else if (current_button == BTN_LEFT)  // ← FIXED: Go to Breakout
+      {
+        AppSnake_Stop();
+        Transition_Load(AppBreakout_GetScreen(), LV_SCR_LOAD_ANIM_MOVE_RIGHT);
+        onSnakePage = false;
+        onBreakoutPage = true;
+        AppBreakout_Enter();
+      }
+      else if (current_button == BTN_RIGHT)  // ← FIXED: Go to Home
+      {
+        AppSnake_Stop();
+        Transition_Load(home_screen, LV_SCR_LOAD_ANIM_MOVE_LEFT);
+        onSnakePage = false;
+      }
+    }
+    else
+    {
+      // ===== GAME OVER: CENTER restarts, LEFT/RIGHT navigate =====
+      if (current_button == BTN_CENTER)
+      {
+        AppSnake_SetDirection(DIR_RIGHT); // Trigger restart
+        beep(40);
+      }
+      else if (current_button == BTN_LEFT)  // ← FIXED: Go to Breakout
+      {
+        AppSnake_Stop();
+        Transition_Load(AppBreakout_GetScreen(), LV_SCR_LOAD_ANIM_MOVE_RIGHT);
+        onSnakePage = false;
+        onBreakoutPage = true;
+        AppBreakout_Enter();
+      }
+      else if (current_button == BTN_RIGHT)  // ← FIXED: Go to Home
+      {
+        AppSnake_Stop();
+        Transition_Load(home_screen, LV_SCR_LOAD_ANIM_MOVE_LEFT);
+        onSnakePage = false;
+      }
+    }
+  }
+  
+  // ========== BREAKOUT PAGE HANDLING ==========
+  else if (onBreakoutPage)
+  {
+    bool playing = AppBreakout_IsPlaying();
+    bool in_menu = AppBreakout_IsInMenu();
+
+    if (playing)
+    {
+      // ===== PLAYING: LEFT/RIGHT control paddle =====
+      if (current_button == BTN_LEFT)
+      {
+        AppBreakout_MovePaddle(-1);
+      }
+      else if (current_button == BTN_RIGHT)
+      {
+        AppBreakout_MovePaddle(1);
+      }
+    }
+    else if (in_menu)
+    {
+      // ===== MENU: CENTER starts, LEFT/RIGHT navigate =====
+      if (current_button == BTN_CENTER)
+      {
+        AppBreakout_Start();
+        beep(40);
+      }
+      else if (current_button == BTN_RIGHT)  // Go to Snake
+      {
+        AppBreakout_Stop();
+        Transition_Load(AppSnake_GetScreen(), LV_SCR_LOAD_ANIM_MOVE_LEFT);
+        onBreakoutPage = false;
+        onSnakePage = true;
+        AppSnake_Enter();
+      }
+      else if (current_button == BTN_LEFT)  // ← Can't go further left
+      {
+        beep(10);  // Just beep, at the edge
+      }
+    }
+    else
+    {
+      // ===== GAME OVER: CENTER restarts, LEFT/RIGHT navigate =====
+      if (current_button == BTN_CENTER)
+      {
+        AppBreakout_MovePaddle(0); // Trigger restart
+        beep(40);
+      }
+      else if (current_button == BTN_RIGHT)  // Go to Snake
+      {
+        AppBreakout_Stop();
+        Transition_Load(AppSnake_GetScreen(), LV_SCR_LOAD_ANIM_MOVE_LEFT);
+        onBreakoutPage = false;
+        onSnakePage = true;
+        AppSnake_Enter();
+      }
+      else if (current_button == BTN_LEFT)  // ← Can't go further left
+      {
+        beep(10);  // Just beep, at the edge
+      }
+    }
+  }
+  
+  // ========== NORMAL PAGE NAVIGATION ==========
+  else
+  {
+    // LEFT from Home -> Snake
+    if (current_button == BTN_LEFT && !onWeatherPage && !onTimerPage)
+    {
+      Transition_Load(AppSnake_GetScreen(), LV_SCR_LOAD_ANIM_MOVE_RIGHT);
+      onSnakePage = true;
+      AppSnake_Enter();
+    }
+    // RIGHT from Home -> Weather
+    else if (current_button == BTN_RIGHT && !onWeatherPage && !onTimerPage)
+    {
+      Transition_Load(AppWeather_GetScreen(), LV_SCR_LOAD_ANIM_MOVE_LEFT);
+      onWeatherPage = true;
+    }
+    // UP/DOWN on Home -> next/previous watch face
+    else if ((current_button == BTN_UP || current_button == BTN_DOWN) && !onWeatherPage && !onTimerPage)
+    {
+      change_face(current_button == BTN_UP ? 1 : -1);
+    }
+    // RIGHT from Weather -> Timer
+    else if (current_button == BTN_RIGHT && onWeatherPage && !onTimerPage)
+    {
+      Transition_Load(AppTimer_GetScreen(), LV_SCR_LOAD_ANIM_MOVE_LEFT);
+      onWeatherPage = false;
+      onTimerPage = true;
+    }
+    // LEFT from Timer -> Weather
+    else if (current_button == BTN_LEFT && onTimerPage)
+    {
+      Transition_Load(AppWeather_GetScreen(), LV_SCR_LOAD_ANIM_MOVE_RIGHT);
+      onTimerPage = false;
+      onWeatherPage = true;
+    }
+    // LEFT from Weather -> Home
+    else if (current_button == BTN_LEFT && onWeatherPage)
+    {
+      Transition_Load(home_screen, LV_SCR_LOAD_ANIM_MOVE_RIGHT);
+      onWeatherPage = false;
+    }
+
+    // ========== TIMER CONTROLS ==========
+    if (onTimerPage)
+    {
+      if (current_button == BTN_CENTER)
+      {
+        AppTimer_Toggle();
+        beep(40);
+      }
+      else if (current_button == BTN_UP)
+      {
+        AppTimer_Adjust(1);
+      }
+      else if (current_button == BTN_DOWN)
+      {
+        AppTimer_Adjust(-1);
+      }
+    }
+  }
+}
+
+// Home face idle: drop to the always-on face
+static void check_idle()
+{
+  bool onHome = !onWeatherPage && !onTimerPage && !onSnakePage && !onBreakoutPage;
+  if (WATCH_AOD_TIMEOUT > 0 && onHome && !AppTimer_IsRunning() && !Transition_IsRunning() &&
+      millis() - lastActivity > WATCH_AOD_TIMEOUT * 1000UL)
+  {
+    Snapshot_SaveIfDue(); // Home face is settled and the user is away: good time for a flash write
+#if WATCH_CLOCK_PRERENDER
+    cancel_next_minute(); // Would be pushed over home after the always-on face, however late
+#endif
+    AppAlwaysOn_Enter();
+  }
+}
+
+#define WATCH_WEATHER_MS 1800000 // Weather refresh
+
+#if WATCH_TASKS
+#if !WATCH_TICKLESS
+#error "WATCH_TASKS needs WATCH_TICKLESS: loop() sleeps on the scheduler and the tasks wake it"
+#endif
+// ========== TASKS ==========
+// loop() stays the one task that touches LVGL: it renders and runs the apps, whose state
+// is all LVGL objects. Input and network run beside it and only talk to it through queues.
+#define INPUT_POLL_MS 10     // Ladder sampling, the rate the polling loop had
+#define INPUT_TASK_STACK 3072
+#define INPUT_TASK_PRIO 2    // Above loop() (1), so sampling stays on time while LVGL renders
+#define NET_TASK_STACK 8192  // HTTPClient + JSON
+#define NET_TASK_PRIO 1
+#define NET_RETRY_MS 10000   // Weather retry while offline or after an HTTP error
+
+static QueueHandle_t button_queue = NULL;  // Button presses, input -> loop
+static QueueHandle_t weather_queue = NULL; // Latest WeatherReading, network -> loop
+static int render_task = -1;
+
+// Samples the ladder and plays queued sounds (a long alarm pauses sampling, as it used to)
+static void input_task(void *arg)
+{
+  int id = (intptr_t)arg;
+  TickType_t wake = xTaskGetTickCount();
+  for (;;)
+  {
+    uint32_t t0 = micros();
+    Button b = take_press(readButton());
+    if (b != BTN_NONE && xQueueSend(button_queue, &b, 0) == pdPASS)
+      Scheduler_Wake();
+    Sound s;
+    while (xQueueReceive(sound_queue, &s, 0) == pdPASS)
+      play(&s);
+    Tasks_AddActive(id, micros() - t0);
+    vTaskDelayUntil(&wake, pdMS_TO_TICKS(INPUT_POLL_MS));
+  }
+}
+
+// WiFi, NTP and the weather fetch; the face is live while this connects
+static void network_task(void *arg)
+{
+  int id = (intptr_t)arg;
+  uint32_t t0 = micros();
+  Serial.println("Connecting to WiFi...");
+  WiFi.begin(ssid, pass);
+  Tasks_AddActive(id, micros() - t0);
+  while (WiFi.status() != WL_CONNECTED)
+    vTaskDelay(pdMS_TO_TICKS(500));
+  Serial.println("WiFi Connected!");
+  beep(250); // WiFi connected confirmation beep
+  configTime(19800, 0, "pool.ntp.org");
+
+  for (;;)
+  {
+    t0 = micros();
+    WeatherReading r;
+    bool ok = WiFi.status() == WL_CONNECTED && AppWeather_Fetch(&r);
+    Tasks_AddActive(id, micros() - t0);
+    if (ok)
+    {
+      xQueueOverwrite(weather_queue, &r);
+      Scheduler_Wake();
+    }
+    vTaskDelay(pdMS_TO_TICKS(ok ? WATCH_WEATHER_MS : NET_RETRY_MS));
+  }
+}
+
+static void start_tasks()
+{
+  render_task = Tasks_Adopt("render", CONFIG_ARDUINO_LOOP_STACK_SIZE);
+  button_queue = xQueueCreate(8, sizeof(Button));
+  weather_queue = xQueueCreate(1, sizeof(WeatherReading));
+  sound_queue = xQueueCreate(4, sizeof(Sound));
+  Tasks_Start("input", input_task, INPUT_TASK_STACK, INPUT_TASK_PRIO, TASKS_UI_CORE);
+  Tasks_Start("net", network_task, NET_TASK_STACK, NET_TASK_PRIO, TASKS_NET_CORE);
+}
+#endif
+
+#if DISPLAY_STATS
+static void print_stats()
+{
+  Display_PrintStats();
+  Display_ResetStats();
+  printAppCpu();
+#if WATCH_TICKLESS
+  SchedulerStats sched;
+  Scheduler_GetStats(&sched);
+  Scheduler_ResetStats();
+  Serial.printf("[sched] %lu wakeups (%lu early), %lu job runs\n", sched.wakeups, sched.early_wakeups, sched.runs);
+#endif
+#if WATCH_TASKS
+  Tasks_PrintStats();
+#endif
+}
+#endif
+
+#if WATCH_TICKLESS
+// ========== JOBS ==========
+// loop() sleeps until the earliest of these deadlines or LVGL's next timer. The buttons sit
+// on an ADC ladder with no edge to interrupt on, so they are sampled as a job as well.
+#define WATCH_BUTTON_POLL_MS 30 // Button sampling outside the games
+#define WATCH_GAME_TICK_MS 10   // Game step and button sampling in the games (the speeds are tuned to it)
+
+static int job_buttons, job_game, job_clock, job_timer, job_weather, job_idle;
+
+static bool in_game()
+{
+  return onSnakePage || onBreakoutPage;
+}
+
+static void on_press(Button b)
+{
+  handle_press(b);
+  Scheduler_In(job_timer, 0); // A press may have started the countdown
+  Scheduler_SetPeriod(job_game, in_game() ? WATCH_GAME_TICK_MS : SCHEDULER_OFF);
+}
+
+#if WATCH_TASKS
+// Presses and weather readings posted by the input and network tasks
+static void take_messages()
+{
+  Button b;
+  while (xQueueReceive(button_queue, &b, 0) == pdPASS)
+    on_press(b);
+  WeatherReading r;
+  if (xQueueReceive(weather_queue, &r, 0) == pdPASS)
+    AppWeather_Show(&r);
+}
+#else
+static void buttons_job()
+{
+  Button b = take_press(readButton());
+  if (b != BTN_NONE)
+    on_press(b);
+  Scheduler_SetPeriod(job_buttons, in_game() ? WATCH_GAME_TICK_MS : WATCH_BUTTON_POLL_MS);
+}
+#endif
+
+static void game_job()
+{
+  if (onSnakePage)
+    AppSnake_Update();
+  else if (onBreakoutPage)
+    AppBreakout_Update();
+}
+
+static void clock_job()
+{
+  if (in_game())
+  {
+#if WATCH_CLOCK_PRERENDER
+    cancel_next_minute(); // Left home for a game inside the lead window
+#endif
+    return;
+  }
+  update_time();
+#if WATCH_CLOCK_PRERENDER
+  clock_flip();
+  Scheduler_In(job_clock, clock_flip_due_ms());
+#endif
+}
+
+// Wakes on each change of the shown seconds while running, otherwise only when a press starts it
+static void timer_job()
+{
+  if (in_game())
+    return;
+  AppTimer_Update();
+  long ms = AppTimer_MsToNextTick();
+  Scheduler_In(job_timer, ms < 0 ? SCHEDULER_OFF : (uint32_t)ms);
+}
+
+#if !WATCH_TASKS
+static void weather_job()
+{
+  if (in_game() || WiFi.status() != WL_CONNECTED)
+  {
+    Scheduler_In(job_weather, 1000);
+    return;
+  }
+  AppWeather_Update();
+}
+#endif
+
+static void start_jobs()
+{
+#if !WATCH_TASKS
+  job_buttons = Scheduler_Add(buttons_job, WATCH_BUTTON_POLL_MS);
+#endif
+  job_game = Scheduler_Add(game_job, SCHEDULER_OFF);
+  job_clock = Scheduler_Add(clock_job, 1000);
+  job_timer = Scheduler_Add(timer_job, 1000);
+  job_idle = Scheduler_Add(check_idle, 1000);
+#if DISPLAY_STATS
+  Scheduler_Add(print_stats, 5000);
+#endif
+#if !WATCH_TASKS
+  job_weather = Scheduler_Add(weather_job, WATCH_WEATHER_MS);
+  Scheduler_In(job_weather, 0); // Like the polling loop: first check right away
+#endif
+}
+#endif
+
+// Screen build time of one app (compare WATCH_SCREEN_GEN=1 with 0), printed with the display statistics
+static void timed_init(const char *name, void (*init)())
+{
+#if DISPLAY_STATS || DISPLAY_BENCH
+  uint32_t t0 = micros();
+  init();
+  Serial.printf("%s init %lu us\n", name, (unsigned long)(micros() - t0));
+#else
+  (void)name;
+  init();
+#endif
 }
 
 void setup()
 {
   Serial.begin(115200);
 
-  // Hardware Init
-  tft.begin();
-  tft.setRotation(2);
+  // Panel first: the last home frame is up before LVGL and WiFi start
+  Display_BeginPanel();
+  Snapshot_Show();
 
-  // LVGL Init
+  // LVGL + Display Init (flush path selected by DISPLAY_DMA_FLUSH)
   lv_init();
-  lv_disp_draw_buf_init(&draw_buf, buf, NULL, 135 * 40);
-  static lv_disp_drv_t disp_drv;
-  lv_disp_drv_init(&disp_drv);
-  disp_drv.hor_res = 135;
-  disp_drv.ver_res = 240;
-  disp_drv.flush_cb = my_disp_flush;
-  disp_drv.draw_buf = &draw_buf;
-  lv_disp_drv_register(&disp_drv);
+  Display_Init();
+  Background_Init();
+  Theme_Init();
+  WatchFace_Init(); // Decodes the saved face before the home screen draws it
 
   // Save the current screen as "Home"
   home_screen = lv_scr_act();
 
   // UI
   create_watch_face();
+#if DISPLAY_BENCH
+  Display_RunBenchmark();
+  DrawSwar_RunBenchmark();
+  Background_RunBenchmark();
+  WatchFace_RunBenchmark();
+  Theme_RunBenchmark();
+  Fonts_RunBenchmark();
+  DigitSprite_RunBenchmark();
+#endif
 
   // Buzzer Setup - BEFORE WiFi for startup sound
   pinMode(BUZZER_PIN, OUTPUT);
   digitalWrite(BUZZER_PIN, LOW);
   beepPattern(2, 80, 100); // Startup sound: beep-beep
 
-  // WiFi - WAIT FOR CONNECTION
+#if !WATCH_TASKS
+  // WiFi - WAIT FOR CONNECTION (network_task with WATCH_TASKS)
   Serial.println("Connecting to WiFi...");
   WiFi.begin(ssid, pass);
   while (WiFi.status() != WL_CONNECTED)
@@ -234,28 +973,110 @@ void setup()
   // Time sync
   configTime(19800, 0, "pool.ntp.org");
   delay(2000);
+#endif
 
   // Initialize Apps
-  AppWeather_Init();
-  AppTimer_Init();
-  AppSnake_Init();
-  AppBreakout_Init();
+  timed_init("weather", AppWeather_Init);
+  timed_init("timer", AppTimer_Init);
+  timed_init("snake", AppSnake_Init);
+  timed_init("breakout", AppBreakout_Init);
+  AppAlwaysOn_Init();
 
   AppTimer_SetAlarmCallback(timerAlarmSound); // Set timer alarm sound
 
+  // Names for the per-app display statistics
+  Display_NameScreen(home_screen, "home");
+  Display_NameScreen(AppWeather_GetScreen(), "weather");
+  Display_NameScreen(AppTimer_GetScreen(), "timer");
+  Display_NameScreen(AppSnake_GetScreen(), "snake");
+  Display_NameScreen(AppBreakout_GetScreen(), "breakout");
+
+#if !WATCH_TASKS
   // Update weather
   AppWeather_Update();
+#endif
 
   // Button Pin (Analog)
   pinMode(BUTTON_PIN, INPUT);
 
+#if WATCH_TASKS
+  start_tasks();
+#endif
+#if WATCH_TICKLESS
+  start_jobs();
+#endif
+
   Serial.println("Setup complete!");
+  Snapshot_ReportBoot();
   beep(50); // Final ready beep
 }
 
 void loop()
 {
+  // ========== ALWAYS-ON MODE ==========
+  // Panel in partial/idle mode; only the minute tick and the buttons are serviced
+  if (AppAlwaysOn_IsActive())
+  {
+#if WATCH_TASKS
+    Button b;
+    if (xQueueReceive(button_queue, &b, pdMS_TO_TICKS(50)) == pdPASS)
+    {
+      AppAlwaysOn_Exit(home_screen); // Wake-up press does not navigate
+      lastActivity = millis();
+      return;
+    }
+    AppAlwaysOn_Update();
+#else
+    if (readButton() != BTN_NONE)
+    {
+      AppAlwaysOn_Exit(home_screen);
+      lastActivity = millis();
+      while (readButton() != BTN_NONE) // Wake-up press does not navigate
+        delay(10);
+      return;
+    }
+    AppAlwaysOn_Update();
+    delay(50);
+#endif
+    return;
+  }
+
+#if WATCH_TICKLESS
+  // Jobs first, so LVGL's next deadline already covers what they invalidated
+  unsigned long loop_start = micros();
+#if WATCH_TASKS
+  take_messages();
+#endif
+  uint32_t sleep_ms = Scheduler_RunDue();
+
+  // ========== REFRESH PERIOD + CPU ==========
+  // LVGL animations (screen load fallback, etc.) keep the default rate while they run
+  AppProfile *app = &app_profiles[currentApp()];
+  Display_SetRefreshPeriod(lv_anim_count_running() ? LV_DISP_DEF_REFR_PERIOD : app->refresh_ms);
+  sleep_ms = min(sleep_ms, (uint32_t)lv_timer_handler());
+  if (!Display_Poll())
+    sleep_ms = min(sleep_ms, (uint32_t)1); // Hand the last stripe's buffer back to LVGL soon
+  app->busy_us += micros() - loop_start;
+  app->wakeups++;
+#if WATCH_TASKS
+  Tasks_AddActive(render_task, micros() - loop_start);
+#endif
+
+  Scheduler_Sleep(sleep_ms);
+  app->total_us += micros() - loop_start;
+#else
+  unsigned long loop_start = micros();
   lv_timer_handler();
+  Display_Poll();
+
+#if DISPLAY_STATS
+  static unsigned long last_stats = 0;
+  if (millis() - last_stats > 5000)
+  {
+    print_stats();
+    last_stats = millis();
+  }
+#endif
 
   // Update time every second (not in game)
   static unsigned long last_tick = 0;
@@ -264,216 +1085,16 @@ void loop()
     update_time();
     last_tick = millis();
   }
+#if WATCH_CLOCK_PRERENDER
+  if (!onSnakePage && !onBreakoutPage)
+    clock_flip();
+  else
+    cancel_next_minute(); // Left home for a game inside the lead window
+#endif
 
-  // ========== BUTTON READING ==========
-  static Button last_button = BTN_NONE;
-  static unsigned long last_press = 0;
-
-  Button current_button = readButton();
-
-  if (current_button != last_button && millis() - last_press > 100)
-  {
-    last_press = millis();
-
-    if (current_button != BTN_NONE)
-    {
-      beep(20);
-
-      // ========== SNAKE PAGE HANDLING ==========
-      if (onSnakePage)
-      {
-        bool playing = AppSnake_IsPlaying();
-        bool in_menu = AppSnake_IsInMenu();
-
-        if (playing)
-        {
-          // ===== PLAYING: Arrow keys control snake =====
-          if (current_button == BTN_UP)
-          {
-            AppSnake_SetDirection(0);
-          }
-          else if (current_button == BTN_DOWN)
-          {
-            AppSnake_SetDirection(2);
-          }
-          else if (current_button == BTN_LEFT)
-          {
-            AppSnake_SetDirection(3);
-          }
-          else if (current_button == BTN_RIGHT)
-          {
-            AppSnake_SetDirection(1);
-          }
-        }
-        else if (in_menu)
-        {
-          // ===== MENU: CENTER starts, LEFT/RIGHT navigate =====
-          if (current_button == BTN_CENTER)
-          {
-            AppSnake_Start();
-            beep(40);
-          }
-          else if (current_button == BTN_LEFT)  // ← FIXED: Go to Breakout
-          {
-            AppSnake_Stop();
-            lv_scr_load_anim(AppBreakout_GetScreen(), LV_SCR_LOAD_ANIM_MOVE_RIGHT, 300, 0, false);
-            onSnakePage = false;
-            onBreakoutPage = true;
-            AppBreakout_Enter();
-          }
-          else if (current_button == BTN_RIGHT)  // ← FIXED: Go to Home
-          {
-            AppSnake_Stop();
-            lv_scr_load_anim(home_screen, LV_SCR_LOAD_ANIM_MOVE_LEFT, 300, 0, false);
-            onSnakePage = false;
-          }
-        }
-        else
-        {
-          // ===== GAME OVER: CENTER restarts, LEFT/RIGHT navigate =====
-          if (current_button == BTN_CENTER)
-          {
-            AppSnake_SetDirection(DIR_RIGHT); // Trigger restart
-            beep(40);
-          }
-          else if (current_button == BTN_LEFT)  // ← FIXED: Go to Breakout
-          {
-            AppSnake_Stop();
-            lv_scr_load_anim(AppBreakout_GetScreen(), LV_SCR_LOAD_ANIM_MOVE_RIGHT, 300, 0, false);
-            onSnakePage = false;
-            onBreakoutPage = true;
-            AppBreakout_Enter();
-          }
-          else if (current_button == BTN_RIGHT)  // ← FIXED: Go to Home
-          {
-            AppSnake_Stop();
-            lv_scr_load_anim(home_screen, LV_SCR_LOAD_ANIM_MOVE_LEFT, 300, 0, false);
-            onSnakePage = false;
-          }
-        }
-      }
-      
-      // ========== BREAKOUT PAGE HANDLING ==========
-      else if (onBreakoutPage)
-      {
-        bool playing = AppBreakout_IsPlaying();
-        bool in_menu = AppBreakout_IsInMenu();
-
-        if (playing)
-        {
-          // ===== PLAYING: LEFT/RIGHT control paddle =====
-          if (current_button == BTN_LEFT)
-          {
-            AppBreakout_MovePaddle(-1);
-          }
-          else if (current_button == BTN_RIGHT)
-          {
-            AppBreakout_MovePaddle(1);
-          }
-        }
-        else if (in_menu)
-        {
-          // ===== MENU: CENTER starts, LEFT/RIGHT navigate =====
-          if (current_button == BTN_CENTER)
-          {
-            AppBreakout_Start();
-            beep(40);
-          }
-          else if (current_button == BTN_RIGHT)  // Go to Snake
-          {
-            AppBreakout_Stop();
-            lv_scr_load_anim(AppSnake_GetScreen(), LV_SCR_LOAD_ANIM_MOVE_LEFT, 300, 0, false);
-            onBreakoutPage = false;
-            onSnakePage = true;
-            AppSnake_Enter();
-          }
-          else if (current_button == BTN_LEFT)  // ← Can't go further left
-          {
-            beep(10);  // Just beep, at the edge
-          }
-        }
-        else
-        {
-          // ===== GAME OVER: CENTER restarts, LEFT/RIGHT navigate =====
-          if (current_button == BTN_CENTER)
-          {
-            AppBreakout_MovePaddle(0); // Trigger restart
-            beep(40);
-          }
-          else if (current_button == BTN_RIGHT)  // Go to Snake
-          {
-            AppBreakout_Stop();
-            lv_scr_load_anim(AppSnake_GetScreen(), LV_SCR_LOAD_ANIM_MOVE_LEFT, 300, 0, false);
-            onBreakoutPage = false;
-            onSnakePage = true;
-            AppSnake_Enter();
-          }
-          else if (current_button == BTN_LEFT)  // ← Can't go further left
-          {
-            beep(10);  // Just beep, at the edge
-          }
-        }
-      }
-      
-      // ========== NORMAL PAGE NAVIGATION ==========
-      else
-      {
-        // LEFT from Home -> Snake
-        if (current_button == BTN_LEFT && !onWeatherPage && !onTimerPage)
-        {
-          lv_scr_load_anim(AppSnake_GetScreen(), LV_SCR_LOAD_ANIM_MOVE_RIGHT, 300, 0, false);
-          onSnakePage = true;
-          AppSnake_Enter();
-        }
-        // RIGHT from Home -> Weather
-        else if (current_button == BTN_RIGHT && !onWeatherPage && !onTimerPage)
-        {
-          lv_scr_load_anim(AppWeather_GetScreen(), LV_SCR_LOAD_ANIM_MOVE_LEFT, 300, 0, false);
-          onWeatherPage = true;
-        }
-        // RIGHT from Weather -> Timer
-        else if (current_button == BTN_RIGHT && onWeatherPage && !onTimerPage)
-        {
-          lv_scr_load_anim(AppTimer_GetScreen(), LV_SCR_LOAD_ANIM_MOVE_LEFT, 300, 0, false);
-          onWeatherPage = false;
-          onTimerPage = true;
-        }
-        // LEFT from Timer -> Weather
-        else if (current_button == BTN_LEFT && onTimerPage)
-        {
-          lv_scr_load_anim(AppWeather_GetScreen(), LV_SCR_LOAD_ANIM_MOVE_RIGHT, 300, 0, false);
-          onTimerPage = false;
-          onWeatherPage = true;
-        }
-        // LEFT from Weather -> Home
-        else if (current_button == BTN_LEFT && onWeatherPage)
-        {
-          lv_scr_load_anim(home_screen, LV_SCR_LOAD_ANIM_MOVE_RIGHT, 300, 0, false);
-          onWeatherPage = false;
-        }
-
-        // ========== TIMER CONTROLS ==========
-        if (onTimerPage)
-        {
-          if (current_button == BTN_CENTER)
-          {
-            AppTimer_Toggle();
-            beep(40);
-          }
-          else if (current_button == BTN_UP)
-          {
-            AppTimer_Adjust(1);
-          }
-          else if (current_button == BTN_DOWN)
-          {
-            AppTimer_Adjust(-1);
-          }
-        }
-      }
-    }
-
-    last_button = current_button;
-  }
+  Button pressed = take_press(readButton());
+  if (pressed != BTN_NONE)
+    handle_press(pressed);
 
   // ========== UPDATES ==========
   if (onSnakePage)
@@ -498,9 +1119,20 @@ void loop()
     }
 
     AppTimer_Update();
+
+    check_idle();
   }
 
+  // ========== REFRESH PERIOD + CPU ==========
+  // LVGL animations (screen load fallback, etc.) keep the default rate while they run
+  AppProfile *app = &app_profiles[currentApp()];
+  Display_SetRefreshPeriod(lv_anim_count_running() ? LV_DISP_DEF_REFR_PERIOD : app->refresh_ms);
+  app->busy_us += micros() - loop_start;
+  app->wakeups++;
+
   delay(10);
+  app->total_us += micros() - loop_start;
+#endif
 }
 // ```
 
@@ -0,0 +1,27 @@
+// Host driver for test_asset_store.py: mounts $ASSET_STORE_FILE through src/AssetStore.cpp
+// and lists what it found. Exit code 0 = mounted, 1 = rejected.
+#include <stdio.h>
+#include <zlib.h>
+#include "AssetStore.h"
+
+int main()
+{
+    bool ok = AssetStore_Mount();
+    if (AssetStore_Mount() != ok) // Second call must give the cached result without a new log line
+        return 2;
+    if (!ok)
+        return 1;
+
+    const char *name;
+    const lv_img_dsc_t *first = AssetStore_At(0, NULL);
+    for (int i = 0; const lv_img_dsc_t *img = AssetStore_At(i, &name); i++)
+    {
+        if (AssetStore_Image(name) != img)
+            return 3;
+        // Data position relative to the first entry: the descriptors point into the mapping
+        printf("asset %s %u %u %u %u %ld %08lx\n", name, (unsigned)img->header.cf, (unsigned)img->header.w,
+               (unsigned)img->header.h, (unsigned)img->data_size, (long)(img->data - first->data),
+               crc32(0, img->data, img->data_size));
+    }
+    return AssetStore_Image("no_such_asset") ? 4 : 0;
+}
@@ -0,0 +1,64 @@
+// Host driver for test_q565.py: decodes the Q565 background of $ASSET_STORE_FILE through
+// the LVGL image decoder src/Background.cpp registers, and writes the frame to argv[1]
+// (LVGL byte order, native-endian uint16). Exit code 0 = decoded, 1 = not in the store,
+// 2 = the decoder reported a wrong header, 3 = a partial or repeated read disagreed.
+#include <stdio.h>
+#include <string.h>
+#include "Background.h"
+#include "Display.h"
+
+// --- LVGL stand-ins: Background_Init registers one decoder, which is called directly ---
+static lv_img_decoder_t decoder;
+
+lv_img_decoder_t *lv_img_decoder_create(void) { return &decoder; }
+void lv_img_decoder_set_info_cb(lv_img_decoder_t *d, lv_img_decoder_info_f_t cb) { d->info_cb = cb; }
+void lv_img_decoder_set_open_cb(lv_img_decoder_t *d, lv_img_decoder_open_f_t cb) { d->open_cb = cb; }
+void lv_img_decoder_set_read_line_cb(lv_img_decoder_t *d, lv_img_decoder_read_line_f_t cb) { d->read_line_cb = cb; }
+lv_img_src_t lv_img_src_get_type(const void *src) { return src ? LV_IMG_SRC_VARIABLE : LV_IMG_SRC_UNKNOWN; }
+lv_obj_t *lv_img_create(lv_obj_t *parent) { return parent; }
+void lv_img_set_src(lv_obj_t *obj, const void *src) {}
+void lv_img_cache_invalidate_src(const void *src) {}
+
+static uint16_t frame[DISPLAY_HEIGHT][DISPLAY_WIDTH];
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+        return 4;
+    Background_Init();
+    const lv_img_dsc_t *img = Background_Image(BG_FORMAT_Q565);
+    if (!img)
+        return 1;
+
+    lv_img_header_t header;
+    if (decoder.info_cb(&decoder, img, &header) != LV_RES_OK || header.cf != LV_IMG_CF_TRUE_COLOR ||
+        header.w != DISPLAY_WIDTH || header.h != DISPLAY_HEIGHT)
+        return 2;
+    lv_img_decoder_dsc_t dsc = {&decoder, img, header, NULL};
+    if (decoder.open_cb(&decoder, &dsc) != LV_RES_OK || dsc.img_data)
+        return 2;
+
+    // Top-down full rows, the way LVGL draws the background
+    for (int y = 0; y < DISPLAY_HEIGHT; y++)
+        decoder.read_line_cb(&decoder, &dsc, 0, y, DISPLAY_WIDTH, (uint8_t *)frame[y]);
+
+    // Bottom-up spans off both edges, each asked twice: a fresh decode from the row offset
+    // table, then the row cache (Background_ReadRow is what the glass tile reads)
+    lv_color_t span[DISPLAY_WIDTH];
+    for (int y = DISPLAY_HEIGHT - 1; y >= 0; y--)
+    {
+        int x = y % 7, len = DISPLAY_WIDTH - x - y % 5;
+        decoder.read_line_cb(&decoder, &dsc, x, y, len, (uint8_t *)span);
+        if (memcmp(span, &frame[y][x], len * 2))
+            return 3;
+        Background_ReadRow(y, x, len, span);
+        if (memcmp(span, &frame[y][x], len * 2))
+            return 3;
+    }
+
+    FILE *out = fopen(argv[1], "wb");
+    if (!out || fwrite(frame, sizeof(frame), 1, out) != 1)
+        return 4;
+    fclose(out);
+    return 0;
+}
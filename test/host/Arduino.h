@@ -0,0 +1,29 @@
+// Host tests only: the few Arduino core pieces the host-built modules use. The firmware
+// always builds against the ESP32 Arduino core.
+#ifndef Arduino_h
+#define Arduino_h
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define IRAM_ATTR
+
+// Serial log lines go to stderr, so drivers can keep stdout for their results
+struct HostSerial
+{
+    int printf(const char *fmt, ...) __attribute__((format(printf, 2, 3)))
+    {
+        va_list args;
+        va_start(args, fmt);
+        int n = vfprintf(stderr, fmt, args);
+        va_end(args);
+        return n;
+    }
+    void println(const char *s) { fprintf(stderr, "%s\n", s); }
+};
+static HostSerial Serial;
+
+#endif
@@ -0,0 +1,90 @@
+// Host tests only: the LVGL 8.3 types and calls the host-built modules use, same layout as
+// lv_img_buf.h / lv_img_decoder.h (LV_BIG_ENDIAN_SYSTEM 0). The firmware always builds
+// against real LVGL; test drivers define the functions.
+#ifndef LVGL_H
+#define LVGL_H
+
+#include <stdint.h>
+
+#ifndef LV_COLOR_16_SWAP
+#define LV_COLOR_16_SWAP 0
+#endif
+#define LV_UNUSED(x) ((void)x)
+
+typedef int16_t lv_coord_t;
+typedef uint8_t lv_res_t;
+enum { LV_RES_INV = 0, LV_RES_OK };
+
+typedef union
+{
+    uint16_t full; // The channel bitfields are not used on the host
+} lv_color_t;
+
+typedef struct
+{
+    lv_coord_t x1, y1, x2, y2;
+} lv_area_t;
+
+typedef struct _lv_obj_t lv_obj_t;
+typedef struct _lv_disp_t lv_disp_t;
+
+enum
+{
+    LV_IMG_CF_RAW = 1,
+    LV_IMG_CF_TRUE_COLOR = 4,
+    LV_IMG_CF_INDEXED_8BIT = 10,
+    LV_IMG_CF_ALPHA_8BIT = 14,
+    LV_IMG_CF_USER_ENCODED_0 = 24,
+};
+
+typedef struct
+{
+    uint32_t cf : 5;
+    uint32_t always_zero : 3;
+    uint32_t reserved : 2;
+    uint32_t w : 11;
+    uint32_t h : 11;
+} lv_img_header_t;
+
+typedef struct
+{
+    lv_img_header_t header;
+    uint32_t data_size;
+    const uint8_t *data;
+} lv_img_dsc_t;
+
+typedef uint8_t lv_img_src_t;
+enum { LV_IMG_SRC_VARIABLE = 0, LV_IMG_SRC_FILE, LV_IMG_SRC_SYMBOL, LV_IMG_SRC_UNKNOWN };
+
+struct _lv_img_decoder_dsc_t;
+typedef struct _lv_img_decoder_t
+{
+    lv_res_t (*info_cb)(struct _lv_img_decoder_t *decoder, const void *src, lv_img_header_t *header);
+    lv_res_t (*open_cb)(struct _lv_img_decoder_t *decoder, struct _lv_img_decoder_dsc_t *dsc);
+    lv_res_t (*read_line_cb)(struct _lv_img_decoder_t *decoder, struct _lv_img_decoder_dsc_t *dsc,
+                             lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t *buf);
+} lv_img_decoder_t;
+
+typedef struct _lv_img_decoder_dsc_t
+{
+    lv_img_decoder_t *decoder;
+    const void *src;
+    lv_img_header_t header;
+    const uint8_t *img_data;
+} lv_img_decoder_dsc_t;
+
+typedef lv_res_t (*lv_img_decoder_info_f_t)(lv_img_decoder_t *, const void *, lv_img_header_t *);
+typedef lv_res_t (*lv_img_decoder_open_f_t)(lv_img_decoder_t *, lv_img_decoder_dsc_t *);
+typedef lv_res_t (*lv_img_decoder_read_line_f_t)(lv_img_decoder_t *, lv_img_decoder_dsc_t *, lv_coord_t, lv_coord_t,
+                                                 lv_coord_t, uint8_t *);
+
+lv_img_decoder_t *lv_img_decoder_create(void);
+void lv_img_decoder_set_info_cb(lv_img_decoder_t *decoder, lv_img_decoder_info_f_t info_cb);
+void lv_img_decoder_set_open_cb(lv_img_decoder_t *decoder, lv_img_decoder_open_f_t open_cb);
+void lv_img_decoder_set_read_line_cb(lv_img_decoder_t *decoder, lv_img_decoder_read_line_f_t read_line_cb);
+lv_img_src_t lv_img_src_get_type(const void *src);
+lv_obj_t *lv_img_create(lv_obj_t *parent);
+void lv_img_set_src(lv_obj_t *obj, const void *src);
+void lv_img_cache_invalidate_src(const void *src);
+
+#endif
@@ -0,0 +1,81 @@
+"""Host test: tools/asset_pack.py pack -> src/AssetStore.cpp mount through $ASSET_STORE_FILE.
+
+    python3 -m unittest discover -s test
+
+Builds test/asset_store_main.cpp with the host C++ compiler ($CXX, default g++) against
+test/host/lvgl.h; skipped when no compiler is found.
+"""
+
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+import unittest
+import zlib
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+sys.path.insert(0, os.path.join(ROOT, "tools"))
+import asset_pack  # noqa: E402
+
+CXX = os.environ.get("CXX", "g++")
+
+ASSETS = [
+    ("bg_raw", "LV_IMG_CF_TRUE_COLOR", 4, 3, bytes(range(24))),
+    ("bg_q565", "LV_IMG_CF_USER_ENCODED_0", 4, 3, b"\x05\x01\x02"),   # Odd size: next entry realigned
+    ("weather_icons", "LV_IMG_CF_ALPHA_8BIT", 2, 10, bytes(range(200, 220))),
+    ("face_night", "LV_IMG_CF_RAW", 4, 3, b"\xff\xd8" + bytes(61) + b"\xff\xd9"),
+]
+
+
+@unittest.skipUnless(shutil.which(CXX), "no host C++ compiler")
+class AssetStoreTest(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls):
+        cls.tmp = tempfile.mkdtemp()
+        cls.exe = os.path.join(cls.tmp, "asset_store")
+        subprocess.check_call([CXX, "-std=gnu++17", "-Wall", "-I", os.path.join(ROOT, "test", "host"),
+                               "-I", os.path.join(ROOT, "include"), os.path.join(ROOT, "test", "asset_store_main.cpp"),
+                               os.path.join(ROOT, "src", "AssetStore.cpp"), "-lz", "-o", cls.exe])
+
+    @classmethod
+    def tearDownClass(cls):
+        shutil.rmtree(cls.tmp)
+
+    def mount(self, image):
+        path = os.path.join(self.tmp, "assets.bin")
+        with open(path, "wb") as f:
+            f.write(image)
+        env = dict(os.environ, ASSET_STORE_FILE=path)
+        run = subprocess.run([self.exe], env=env, stdout=subprocess.PIPE, universal_newlines=True)
+        return run.returncode, run.stdout
+
+    def test_mount_lists_every_asset(self):
+        image = asset_pack.pack(ASSETS)
+        code, out = self.mount(image)
+        self.assertEqual(code, 0, out)
+        listed = [line.split()[1:] for line in out.splitlines() if line.startswith("asset ")]
+        packed = asset_pack.unpack(image)
+        self.assertEqual(len(listed), len(ASSETS))
+        for (name, cf, w, h, blob), row, entry in zip(ASSETS, listed, packed):
+            self.assertEqual(row[0], name)
+            self.assertEqual([int(v) for v in row[1:5]], [asset_pack.LV_IMG_CF[cf], w, h, len(blob)])
+            self.assertEqual(int(row[5]), entry[4] - packed[0][4])  # Points at its bytes in the mapping
+            self.assertEqual(int(row[6], 16), zlib.crc32(blob) & 0xFFFFFFFF)
+
+    def test_corrupt_copy_fails_crc(self):
+        image = bytearray(asset_pack.pack(ASSETS))
+        name, cf, w, h, offset, size = asset_pack.unpack(bytes(image))[-1]
+        image[offset + size // 2] ^= 0x40  # One bit inside the last asset's data
+        code, out = self.mount(bytes(image))
+        self.assertEqual(code, 1, out)
+        self.assertEqual(out.count("CRC mismatch"), 1)  # Rejected once, not re-checked
+
+    def test_erased_partition_is_rejected(self):
+        code, out = self.mount(b"\xff" * 4096)
+        self.assertEqual(code, 1, out)
+        self.assertIn("no valid pack", out)
+
+
+if __name__ == "__main__":
+    unittest.main()
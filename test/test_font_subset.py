@@ -0,0 +1,108 @@
+"""Host test: tools/font_subset.py over LVGL's own Montserrat sources.
+
+    LVGL_DIR=<path to lvgl 8.3> python3 -m unittest discover -s test
+
+Without LVGL_DIR the lvgl package PlatformIO installed from lib_deps (.pio/libdeps/*/lvgl)
+is used; skipped when neither is there. Every glyph of FONT_SUBSETS is looked up through
+the subset's rebuilt cmaps and glyph ids and must carry the full font's metrics, bitmap
+and kerning; the compressed variant must decode to the same pixels.
+"""
+
+import glob
+import os
+import sys
+import unittest
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+sys.path.insert(0, os.path.join(ROOT, "tools"))
+import font_subset as fs  # noqa: E402
+
+
+def font_dir():
+    dirs = [os.environ["LVGL_DIR"]] if os.environ.get("LVGL_DIR") else []
+    dirs += sorted(glob.glob(os.path.join(ROOT, ".pio", "libdeps", "*", "lvgl")))
+    for d in dirs:
+        path = os.path.join(d, "src", "font")
+        if all(os.path.exists(os.path.join(path, "lv_font_montserrat_%d.c" % s)) for s in fs.FONT_SUBSETS):
+            return path
+    return None
+
+
+FONT_DIR = font_dir()
+
+
+def subset_gid(sub, c):
+    """Glyph id of code point c, looked up the way LVGL walks lv_font_fmt_txt_cmap_t."""
+    for cmap in sub["cmaps"]:
+        ofs = c - cmap["start"]
+        if not 0 <= ofs < cmap["length"]:
+            continue
+        if cmap["list"] is None:
+            return cmap["gid"] + ofs
+        if ofs in cmap["list"]:
+            return cmap["gid"] + cmap["list"].index(ofs)
+    return 0
+
+
+def kern_value(kern, left_gid, right_gid):
+    l, r = kern["left"][left_gid], kern["right"][right_gid]
+    return kern["values"][(l - 1) * kern["right_cnt"] + (r - 1)] if l and r else 0
+
+
+@unittest.skipUnless(FONT_DIR, "LVGL sources not found (set LVGL_DIR or run `pio pkg install`)")
+class FontSubsetTest(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls):
+        cls.fonts = {size: fs.parse_font(os.path.join(FONT_DIR, "lv_font_montserrat_%d.c" % size))
+                     for size in fs.FONT_SUBSETS}
+
+    def check_subset(self, size, compress):
+        font = self.fonts[size]
+        sub = fs.subset_font(font, fs.FONT_SUBSETS[size], compress)
+        bpp = font["bpp"]
+        gids = {}
+        for c in fs.FONT_SUBSETS[size]:
+            gid = subset_gid(sub, c)
+            self.assertGreater(gid, 0, "U+%04X not reachable through the cmaps" % c)
+            gids[c] = gid
+            full, glyph = font["glyphs"][c], sub["dsc"][gid - 1]
+            for key in ("adv_w", "box_w", "box_h", "ofs_x", "ofs_y"):
+                self.assertEqual(glyph[key], full[key], "%d px U+%04X %s" % (size, c, key))
+            end = sub["dsc"][gid]["bitmap_index"] if gid < len(sub["dsc"]) else len(sub["bitmap"])
+            data = sub["bitmap"][glyph["bitmap_index"]:end]
+            if compress and full["box_w"] and full["box_h"]:
+                self.assertEqual(fs.decompress_glyph(data, full["box_w"], full["box_h"], bpp),
+                                 fs._pixels(full["bitmap"], full["box_w"] * full["box_h"], bpp), "%d px U+%04X" % (size, c))
+            else:
+                self.assertEqual(data, full["bitmap"], "%d px U+%04X bitmap" % (size, c))
+        # Nothing else is reachable
+        self.assertEqual(len(sub["dsc"]), len(set(gids.values())))
+
+        if font["kern"]:
+            for a in gids:
+                for b in gids:
+                    self.assertEqual(kern_value(sub["kern"], gids[a], gids[b]),
+                                     kern_value(font["kern"], font["glyphs"][a]["gid"], font["glyphs"][b]["gid"]),
+                                     "%d px kerning U+%04X U+%04X" % (size, a, b))
+
+    def test_glyphs_match_full_font(self):
+        for size in fs.FONT_SUBSETS:
+            self.check_subset(size, compress=False)
+
+    def test_compressed_glyphs_match_full_font(self):
+        for size in fs.FONT_SUBSETS:
+            self.check_subset(size, compress=True)
+
+    def test_report(self):
+        text, report = fs.build(FONT_DIR)
+        self.assertEqual(len(report), len(fs.FONT_SUBSETS))
+        for size, line in zip(sorted(fs.FONT_SUBSETS), report):
+            print("\n" + line, end="")
+            self.assertIn("watch_font_%d" % size, text)
+            font = self.fonts[size]
+            sub = fs.subset_font(font, fs.FONT_SUBSETS[size])
+            self.assertLess(fs.subset_bytes(sub), fs.source_bytes(font), line)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,163 @@
+"""Host test: tools/asset_pipeline.py encode_q565 -> the Q565 decoder in src/Background.cpp.
+
+    python3 -m unittest discover -s test
+
+Builds test/background_main.cpp with src/Background.cpp and src/AssetStore.cpp against
+test/host/ ($CXX, default g++; skipped when no compiler is found), packs each test frame
+as bg_q565 into an asset pack and compares what the firmware's image decoder reads back
+with the encoder's input.
+"""
+
+import os
+import random
+import shutil
+import struct
+import subprocess
+import sys
+import tempfile
+import unittest
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+sys.path.insert(0, os.path.join(ROOT, "tools"))
+import asset_pack  # noqa: E402
+import asset_pipeline as ap  # noqa: E402
+
+CXX = os.environ.get("CXX", "g++")
+W, H = 135, 240  # Default build; frames are made of test rows cycled down the panel
+BUILDS = {  # (width, height, LV_COLOR_16_SWAP)
+    "default": (W, H, 0),
+    "swapped": (W, H, 1),
+    "240x320": (240, 320, 0),
+}
+
+
+def rgb(r, g, b):
+    return (r & 0x1F) << 11 | (g & 0x3F) << 5 | (b & 0x1F)
+
+
+def pad(row, width=W):
+    """A test row at full panel width; the filler is an unrelated colour."""
+    return (row + [0x5AA5] * width)[:width]
+
+
+@unittest.skipUnless(shutil.which(CXX), "no host C++ compiler")
+class Q565Test(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls):
+        cls.tmp = tempfile.mkdtemp()
+        cls.exe = {}
+        for name, (w, h, swap) in BUILDS.items():
+            cls.exe[name] = os.path.join(cls.tmp, "background_" + name)
+            subprocess.check_call([CXX, "-std=gnu++17", "-Wall", "-DTFT_WIDTH=%d" % w, "-DTFT_HEIGHT=%d" % h,
+                                   "-DLV_COLOR_16_SWAP=%d" % swap, "-I", os.path.join(ROOT, "test", "host"),
+                                   "-I", os.path.join(ROOT, "include"), os.path.join(ROOT, "test", "background_main.cpp"),
+                                   os.path.join(ROOT, "src", "Background.cpp"), os.path.join(ROOT, "src", "AssetStore.cpp"),
+                                   "-lz", "-o", cls.exe[name]])
+
+    @classmethod
+    def tearDownClass(cls):
+        shutil.rmtree(cls.tmp)
+
+    def decode(self, pixels, build="default"):
+        """Encode a full frame, decode it on the firmware side, return plain RGB565 pixels."""
+        w, h, swap = BUILDS[build]
+        self.assertEqual(len(pixels), w * h)
+        blob = ap.encode_q565(pixels, w, h)
+        store = os.path.join(self.tmp, "assets.bin")
+        with open(store, "wb") as f:
+            f.write(asset_pack.pack([("bg_q565", "LV_IMG_CF_USER_ENCODED_0", w, h, blob)]))
+        out = os.path.join(self.tmp, "frame.bin")
+        run = subprocess.run([self.exe[build], out], env=dict(os.environ, ASSET_STORE_FILE=store),
+                             stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+        self.assertEqual(run.returncode, 0, run.stdout)
+        with open(out, "rb") as f:
+            decoded = list(struct.unpack("=%dH" % (w * h), f.read()))
+        return [ap.swap16(p) for p in decoded] if swap else decoded
+
+    def check(self, pixels, build="default"):
+        w, h, _ = BUILDS[build]
+        decoded = self.decode(pixels, build)
+        for y in range(h):  # Row by row: a diff of the whole frame takes minutes to print
+            self.assertEqual(decoded[y * w:(y + 1) * w], pixels[y * w:(y + 1) * w], "%s row %d" % (build, y))
+
+    def round_trip(self, rows, build="default"):
+        h = BUILDS[build][1]
+        self.check([p for y in range(h) for p in rows[y % len(rows)]], build)
+
+    def ops(self, row):
+        return list(ap._q565_row(row))
+
+    def test_runs(self):
+        rows = []
+        for n in (1, 61, 62, 63, 124, 125):
+            rows.append(pad([0x1234] + [0xBEEF] * n + [0x1234]))
+            rows.append(pad([0] * n))  # Starts as a run of the implicit black pixel
+        rows.append([0xFFFF] * W)  # One run across the whole row, ending at its last pixel
+        rows.append([0] * W)
+        self.round_trip(rows)
+        # No run op may collide with the RGB literal
+        self.assertEqual(self.ops([0] * 200), [0xFD, 0xFD, 0xFD, 0xC0 | 13])
+
+    def test_index(self):
+        a, b = rgb(31, 0, 0), rgb(0, 63, 0)
+        self.assertNotEqual(ap._q565_hash(a), ap._q565_hash(b))
+        self.assertIn(ap.Q565_OP_INDEX | ap._q565_hash(a), self.ops([a, b, a]))
+        # Black hashes to slot 0, which the empty index already holds
+        self.assertEqual(self.ops([0, 1]), [ap.Q565_OP_RUN, ap.Q565_OP_DIFF | 2 << 4 | 2 << 2 | 3])
+        # Same slot, different colour: the slot is overwritten, not reused
+        slots = {}
+        for p in range(1, 1 << 16):
+            slots.setdefault(ap._q565_hash(p), []).append(p)
+        c, d = slots[7][:2]
+        self.round_trip([pad([a, b, a, b, 0, a]), pad([c, d, c, d, d, c]), pad([0, 1, 0, 1])])
+
+    def test_diff_edges(self):
+        base = rgb(16, 32, 16)
+        rows = []
+        for d in (-2, -1, 1):
+            row = [base, rgb(16 + d, 32 + d, 16 + d)]
+            self.assertEqual(self.ops(row)[-1] & 0xC0, ap.Q565_OP_DIFF)
+            rows.append(pad(row))
+        rows.append(pad([0, rgb(31, 63, 31), 0]))  # Wrap-around: 0 - 1 is 31 / 63 in the channel
+        self.round_trip(rows)
+
+    def test_luma_edges(self):
+        base = rgb(16, 32, 16)
+        rows = []
+        for dg in (-32, -31, -3, 2, 30, 31):
+            for rel in (-8, 7):
+                if not -16 <= (dg >> 1) + rel <= 15:
+                    continue  # dr itself wraps to the other sign: not a LUMA delta
+                p = rgb(16 + (dg >> 1) + rel, 32 + dg, 16 + (dg >> 1) + rel)
+                self.assertEqual(self.ops([base, p])[-2] & 0xC0, ap.Q565_OP_LUMA, (dg, rel))
+                rows.append(pad([base, p]))
+        self.round_trip(rows)
+
+    def test_rgb_literal(self):
+        base = rgb(16, 32, 16)
+        rows = []
+        # Just outside LUMA: dr - dg/2 of -9 and 8, and db - dg/2 far out
+        for p in (rgb(16 - 1 - 9, 32 - 2, 16), rgb(16 + 8, 32, 16), rgb(0, 0, 31), 0xFE00):
+            self.assertEqual(self.ops([base, p])[-3:], [ap.Q565_OP_RGB, p >> 8, p & 0xFF], hex(p))
+            rows.append(pad([base, p]))
+        self.round_trip(rows)
+
+    def test_random_rows(self):
+        rnd = random.Random(565)
+        palette = [rnd.randrange(1 << 16) for _ in range(80)]
+        pixels = []
+        while len(pixels) < W * H:
+            p = rnd.choice(palette) if rnd.random() < 0.7 else (pixels[-1] if pixels else 0) ^ rnd.randrange(4)
+            pixels += [p] * rnd.choice((1, 1, 2, 5, 63, 130))
+        self.round_trip([pixels[y * W:(y + 1) * W] for y in range(H)])
+
+    def test_photo(self):
+        photo = ap.load_background()
+        self.assertLess(len(ap.encode_q565(photo, ap.BG_WIDTH, ap.BG_HEIGHT)), len(photo) * 2)
+        self.check(photo)
+        self.check(photo, "swapped")
+        self.check(ap.resample(photo, ap.BG_WIDTH, ap.BG_HEIGHT, 240, 320), "240x320")
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,95 @@
+"""Asset partition container ("WAST"), see src/AssetStore.cpp.
+
+Layout (little endian, offsets from the partition start):
+    header   u32 magic "WAST", u16 version, u16 count, u32 total size, u32 CRC-32 of bytes 16..total
+    entries  count x {char name[16], u32 offset, u32 size, u8 cf, u8 0, u16 w, u16 h, u16 0}
+    data     each entry 4-byte aligned, exactly the bytes of an lv_img_dsc_t's data
+
+Used by asset_pipeline.py to write $BUILD_DIR/generated/assets.bin. On the host:
+    python tools/asset_pack.py list <assets.bin>                  entries + CRC check
+    python tools/asset_pack.py offset <partitions.csv> [name]     where it gets flashed
+"""
+
+import struct
+import sys
+import zlib
+
+ASSET_MAGIC = b"WAST"
+ASSET_VERSION = 1
+ASSET_NAME_LEN = 16
+HEADER = struct.Struct("<4sHHII")
+ENTRY = struct.Struct("<%dsIIBBHHH" % ASSET_NAME_LEN)
+PARTITION_NAME = "assets"
+ASSET_STORE_MAX = 16  # Entries the firmware accepts (include/AssetStore.h)
+
+# lv_img_cf_t values (LVGL 8)
+LV_IMG_CF = {
+    "LV_IMG_CF_RAW": 1,  # Encoded file bytes (JPEG faces)
+    "LV_IMG_CF_TRUE_COLOR": 4,
+    "LV_IMG_CF_TRUE_COLOR_ALPHA": 5,
+    "LV_IMG_CF_INDEXED_8BIT": 10,
+    "LV_IMG_CF_ALPHA_8BIT": 14,
+    "LV_IMG_CF_USER_ENCODED_0": 0x18,
+}
+
+
+def _align4(n):
+    return (n + 3) & ~3
+
+
+def pack(assets):
+    """assets: list of (name, cf name, w, h, bytes). Returns the partition image."""
+    if len(assets) > ASSET_STORE_MAX:
+        raise ValueError("%d assets, the firmware takes %d" % (len(assets), ASSET_STORE_MAX))
+    offset = _align4(HEADER.size + ENTRY.size * len(assets))
+    entries, data = b"", b""
+    for name, cf, w, h, blob in assets:
+        if len(name) >= ASSET_NAME_LEN:
+            raise ValueError("asset name too long: %s" % name)
+        entries += ENTRY.pack(name.encode(), offset + len(data), len(blob), LV_IMG_CF[cf], 0, w, h, 0)
+        data += bytes(blob)
+        data += b"\0" * (_align4(len(data)) - len(data))
+    body = entries + b"\0" * (offset - HEADER.size - len(entries)) + data
+    total = HEADER.size + len(body)
+    return HEADER.pack(ASSET_MAGIC, ASSET_VERSION, len(assets), total, zlib.crc32(body) & 0xFFFFFFFF) + body
+
+
+def unpack(image):
+    """Return [(name, cf, w, h, offset, size)] after checking magic, bounds and CRC."""
+    magic, version, count, total, crc = HEADER.unpack_from(image)
+    if magic != ASSET_MAGIC or version != ASSET_VERSION:
+        raise ValueError("not an asset pack (version %d)" % ASSET_VERSION)
+    if total > len(image) or zlib.crc32(image[HEADER.size:total]) & 0xFFFFFFFF != crc:
+        raise ValueError("asset pack truncated or corrupt")
+    out = []
+    for i in range(count):
+        name, offset, size, cf, _, w, h, _ = ENTRY.unpack_from(image, HEADER.size + i * ENTRY.size)
+        if offset + size > total:
+            raise ValueError("entry %d out of bounds" % i)
+        out.append((name.rstrip(b"\0").decode(), cf, w, h, offset, size))
+    return out
+
+
+def partition(csv_path, name=PARTITION_NAME):
+    """(offset, size) of partition `name` in a PlatformIO partitions CSV."""
+    with open(csv_path) as f:
+        for line in f:
+            cols = [c.strip() for c in line.split("#")[0].split(",")]
+            if len(cols) >= 5 and cols[0] == name:
+                return int(cols[3], 0), int(cols[4], 0)
+    raise ValueError("no '%s' partition in %s" % (name, csv_path))
+
+
+if __name__ == "__main__":
+    if len(sys.argv) >= 3 and sys.argv[1] == "list":
+        with open(sys.argv[2], "rb") as f:
+            image = f.read()
+        cf_names = {v: k for k, v in LV_IMG_CF.items()}
+        for name, cf, w, h, offset, size in unpack(image):
+            print("%-16s %-28s %4dx%-4d @0x%06x %7d B" % (name, cf_names.get(cf, cf), w, h, offset, size))
+        print("%d bytes, CRC ok" % HEADER.unpack_from(image)[3])
+    elif len(sys.argv) >= 3 and sys.argv[1] == "offset":
+        print("0x%X 0x%X" % partition(*sys.argv[2:4]))
+    else:
+        print(__doc__)
+        sys.exit(1)
@@ -0,0 +1,655 @@
+"""Build-time asset pipeline.
+
+Runs as a PlatformIO pre-script (see extra_scripts in platformio.ini) and turns the
+checked-in image headers into the variants the current build flags ask for. Generated
+headers are written to $BUILD_DIR/generated, which is put in front of include/ so that
+`#include "bg_image.h"` picks up the generated copy without touching the sources.
+The weather icons always come from here, as one atlas (weather_icon_atlas.h) in the
+WEATHER_ICON_FORMAT variant; include/weather_icons.h is only the source artwork.
+The background is also encoded as Q565 (bg_image_q565.h, see encode_q565) and as
+dithered indexed-8 (bg_image_i8.h, see encode_indexed8). All images that fill the screen
+are made at the panel size (TFT_WIDTH x TFT_HEIGHT); on a panel other than the photo's
+own 135x240 it is scaled to cover it (see resample) and bg_image.h is generated too.
+With WATCH_FONT_SUBSET the Montserrat fonts are cut down to the glyphs the screens use
+(watch_fonts.h, see font_subset.py); watch_font_conf.h is forced into every translation
+unit so LVGL's default font is the subset too.
+Every image also goes into assets.bin, the image of the "assets" flash partition (see
+asset_pack.py); with WATCH_ASSET_STORE the firmware maps it instead of linking the arrays.
+With WATCH_FACES the extra home faces are added to it as baseline JPEGs (see build_faces).
+The app screens described in screens/*.json become screen_<name>.h (see screen_gen.py);
+after linking, the code size of every screen builder is printed.
+
+It can also be run on the host for inspection:
+    python tools/asset_pipeline.py <out_dir> [DEFINE=VALUE ...]
+(fonts need LVGL_DIR=<path to the lvgl library> in the environment, and PARTITIONS=<csv>
+selects another partition table, e.g. partitions_large.csv for the larger panels)
+"""
+
+import math
+import os
+import re
+import struct
+import subprocess
+import sys
+
+PROJECT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+sys.path.insert(0, os.path.join(PROJECT_DIR, "tools"))
+
+import asset_pack  # noqa: E402
+import font_subset  # noqa: E402
+import jpeg_encode  # noqa: E402
+import screen_gen  # noqa: E402
+
+INCLUDE_DIR = os.path.join(PROJECT_DIR, "include")
+FACES_DIR = os.path.join(PROJECT_DIR, "assets", "faces")
+SCREENS_DIR = os.path.join(PROJECT_DIR, "screens")
+PARTITIONS_CSV = os.path.join(PROJECT_DIR, "partitions.csv")
+
+BG_WIDTH = 135  # The photo in include/bg_image.h
+BG_HEIGHT = 240
+ICON_NAMES = ["clear", "wind", "stormy", "cloudy", "temp", "rainy"]
+ICON_SIZE = 30
+
+
+# ---------- Parsing ----------
+
+def _strip_comments(text):
+    text = re.sub(r"/\*.*?\*/", "", text, flags=re.S)
+    return re.sub(r"//[^\n]*", "", text)
+
+
+def read_array(path, name):
+    """Return the integer initializers of the C array `name` in `path`."""
+    with open(path) as f:
+        text = _strip_comments(f.read())
+    m = re.search(r"\b%s\s*\[\s*\]\s*[^=]*=\s*\{(.*?)\};" % re.escape(name), text, flags=re.S)
+    if not m:
+        raise ValueError("array %s not found in %s" % (name, path))
+    return [int(tok, 16) for tok in re.findall(r"0x[0-9A-Fa-f]+", m.group(1))]
+
+
+def load_background(width=BG_WIDTH, height=BG_HEIGHT):
+    """The photo as RGB565 pixels, scaled to cover width x height."""
+    pixels = read_array(os.path.join(INCLUDE_DIR, "bg_image.h"), "my_image_map")
+    if len(pixels) != BG_WIDTH * BG_HEIGHT:
+        raise ValueError("my_image_map has %d pixels, expected %d" % (len(pixels), BG_WIDTH * BG_HEIGHT))
+    if (width, height) != (BG_WIDTH, BG_HEIGHT):
+        pixels = resample(pixels, BG_WIDTH, BG_HEIGHT, width, height)
+    return pixels
+
+
+def load_icons():
+    path = os.path.join(INCLUDE_DIR, "weather_icons.h")
+    icons = {}
+    for name in ICON_NAMES:
+        data = read_array(path, name + "_map")
+        if len(data) != ICON_SIZE * ICON_SIZE * 3:
+            raise ValueError("%s_map has %d bytes" % (name, len(data)))
+        icons[name] = data
+    return icons
+
+
+# ---------- Transforms ----------
+
+def swap16(value):
+    return ((value & 0xFF) << 8) | (value >> 8)
+
+
+def blend565(fg, bg, alpha):
+    """fg over bg in RGB565 units, rounded."""
+    out = 0
+    for shift, mask in ((11, 0x1F), (5, 0x3F), (0, 0x1F)):
+        f, b = (fg >> shift) & mask, (bg >> shift) & mask
+        out |= ((f * alpha + b * (255 - alpha) + 127) // 255) << shift
+    return out
+
+
+def rgb888_to_565(rgb):
+    return ((rgb >> 19) & 0x1F) << 11 | ((rgb >> 10) & 0x3F) << 5 | (rgb >> 3) & 0x1F
+
+
+def resample(pixels, sw, sh, dw, dh):
+    """Bilinear scale of RGB565 pixels to cover dw x dh, cropping the overhang evenly."""
+    scale = max(float(dw) / sw, float(dh) / sh)
+    x0 = (sw - dw / scale) / 2
+    y0 = (sh - dh / scale) / 2
+    rgb = [rgb565_to_888(p) for p in pixels]
+    out = []
+    for y in range(dh):
+        fy = min(max(y0 + (y + 0.5) / scale - 0.5, 0), sh - 1)
+        iy = min(int(fy), sh - 2)
+        wy = fy - iy
+        for x in range(dw):
+            fx = min(max(x0 + (x + 0.5) / scale - 0.5, 0), sw - 1)
+            ix = min(int(fx), sw - 2)
+            wx = fx - ix
+            a, b = rgb[iy * sw + ix], rgb[iy * sw + ix + 1]
+            c, d = rgb[(iy + 1) * sw + ix], rgb[(iy + 1) * sw + ix + 1]
+            r, g, bl = ((a[k] * (1 - wx) + b[k] * wx) * (1 - wy) + (c[k] * (1 - wx) + d[k] * wx) * wy + 0.5
+                        for k in range(3))
+            out.append(rgb888_to_565(int(r) << 16 | int(g) << 8 | int(bl)))
+    return out
+
+
+def icon_tint(data):
+    """Alpha-weighted mean colour of a [lo, hi, a] icon as 0xRRGGBB."""
+    total = [0, 0, 0]
+    weight = 0
+    for i in range(0, len(data), 3):
+        rgb = rgb565_to_888(data[i] | data[i + 1] << 8)
+        for k in range(3):
+            total[k] += rgb[k] * data[i + 2]
+        weight += data[i + 2]
+    r, g, b = (t // weight if weight else 0 for t in total)
+    return r << 16 | g << 8 | b
+
+
+# Weather icon atlas variants (WEATHER_ICON_FORMAT)
+ICON_FORMAT_ARGB = 0    # LV_IMG_CF_TRUE_COLOR_ALPHA as drawn before, 3 bytes/px
+ICON_FORMAT_OPAQUE = 1  # Pre-blended on WEATHER_ICON_BG, LV_IMG_CF_TRUE_COLOR, 2 bytes/px
+ICON_FORMAT_A8 = 2      # Alpha only, recoloured at draw time, 1 byte/px
+
+
+def build_icon_atlas(icons, fmt, bg_rgb, swap):
+    """Return (bytes, cf, bytes per pixel, note) with all icons stacked vertically."""
+    bg = rgb888_to_565(bg_rgb)
+    data = []
+    for name in ICON_NAMES:
+        px = icons[name]
+        for i in range(0, len(px), 3):
+            c, a = px[i] | px[i + 1] << 8, px[i + 2]
+            if fmt == ICON_FORMAT_OPAQUE:
+                c = blend565(c, bg, a)
+                c = swap16(c) if swap else c
+                data += [c & 0xFF, c >> 8]
+            elif fmt == ICON_FORMAT_A8:
+                data.append(a)
+            else:
+                c = swap16(c) if swap else c
+                data += [c & 0xFF, c >> 8, a]
+    if fmt == ICON_FORMAT_OPAQUE:
+        return data, "LV_IMG_CF_TRUE_COLOR", 2, "opaque RGB565 on 0x%06X" % bg_rgb
+    if fmt == ICON_FORMAT_A8:
+        return data, "LV_IMG_CF_ALPHA_8BIT", 1, "A8 masks"
+    return data, "LV_IMG_CF_TRUE_COLOR_ALPHA", 3, "RGB565 + alpha"
+
+
+# Q565: QOI-style RGB565 codec. Every row restarts the codec state and the row offset
+# table lets the decoder start at any row, so a draw stripe only expands the rows it needs.
+# Layout (little endian): "Q565", u16 width, u16 height, u32 offset[height + 1], streams.
+Q565_MAGIC = b"Q565"
+Q565_OP_INDEX = 0x00  # 00iiiiii             pixel = index[i]
+Q565_OP_DIFF = 0x40   # 01rrggbb             channel deltas -2..1 from the previous pixel
+Q565_OP_LUMA = 0x80   # 10gggggg rrrrbbbb    dg -32..31, dr/db -8..7 relative to dg/2
+Q565_OP_RUN = 0xC0    # 11nnnnnn             previous pixel n+1 more times (n < 62)
+Q565_OP_RGB = 0xFE    # 11111110 hi lo       literal RGB565
+Q565_MAX_RUN = 62
+
+
+def _q565_hash(p):
+    return ((p >> 11) * 3 + ((p >> 5) & 0x3F) * 5 + (p & 0x1F) * 7) & 63
+
+
+def _q565_row(row):
+    out = bytearray()
+    index = [0] * 64
+    prev = 0
+    run = 0
+    for p in row:
+        if p == prev:
+            run += 1
+            if run == Q565_MAX_RUN:
+                out.append(Q565_OP_RUN | (run - 1))
+                run = 0
+            continue
+        if run:
+            out.append(Q565_OP_RUN | (run - 1))
+            run = 0
+        h = _q565_hash(p)
+        if index[h] == p:
+            out.append(Q565_OP_INDEX | h)
+        else:
+            index[h] = p
+            dr = ((p >> 11) - (prev >> 11) + 16) % 32 - 16
+            dg = (((p >> 5) & 0x3F) - ((prev >> 5) & 0x3F) + 32) % 64 - 32
+            db = ((p & 0x1F) - (prev & 0x1F) + 16) % 32 - 16
+            dr_g = dr - (dg >> 1)
+            db_g = db - (dg >> 1)
+            if -2 <= dr <= 1 and -2 <= dg <= 1 and -2 <= db <= 1:
+                out.append(Q565_OP_DIFF | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2))
+            elif -8 <= dr_g <= 7 and -8 <= db_g <= 7:
+                out += bytes([Q565_OP_LUMA | (dg + 32), (dr_g + 8) << 4 | (db_g + 8)])
+            else:
+                out += bytes([Q565_OP_RGB, p >> 8, p & 0xFF])
+        prev = p
+    if run:
+        out.append(Q565_OP_RUN | (run - 1))
+    return out
+
+
+def encode_q565(pixels, width, height):
+    """Encode native RGB565 pixels; the decoder applies LV_COLOR_16_SWAP itself."""
+    rows = [_q565_row(pixels[y * width:(y + 1) * width]) for y in range(height)]
+    offset = len(Q565_MAGIC) + 4 + 4 * (height + 1)
+    blob = bytearray(Q565_MAGIC) + width.to_bytes(2, "little") + height.to_bytes(2, "little")
+    for row in rows:
+        blob += offset.to_bytes(4, "little")
+        offset += len(row)
+    blob += offset.to_bytes(4, "little")
+    for row in rows:
+        blob += row
+    return bytes(blob)
+
+
+# Indexed-8: median-cut palette + ordered dither, LV_IMG_CF_INDEXED_8BIT layout
+# (256 x lv_color32_t palette as B, G, R, A, then one index byte per pixel).
+I8_DITHER = 8  # Bayer offset span in 8-bit units; 0 = nearest colour only
+BAYER8 = [
+    [0, 32, 8, 40, 2, 34, 10, 42], [48, 16, 56, 24, 50, 18, 58, 26],
+    [12, 44, 4, 36, 14, 46, 6, 38], [60, 28, 52, 20, 62, 30, 54, 22],
+    [3, 35, 11, 43, 1, 33, 9, 41], [51, 19, 59, 27, 49, 17, 57, 25],
+    [15, 47, 7, 39, 13, 45, 5, 37], [63, 31, 55, 23, 61, 29, 53, 21],
+]
+
+
+def rgb565_to_888(p):
+    r, g, b = p >> 11, (p >> 5) & 0x3F, p & 0x1F
+    return (r << 3 | r >> 2, g << 2 | g >> 4, b << 3 | b >> 2)
+
+
+def _median_cut(colors, count):
+    boxes = [colors]
+    while len(boxes) < count:
+        best = None
+        for i, box in enumerate(boxes):
+            if len(box) < 2:
+                continue
+            spans = [max(c[k] for c in box) - min(c[k] for c in box) for k in range(3)]
+            k = spans.index(max(spans))
+            if best is None or spans[k] * len(box) > best[0]:
+                best = (spans[k] * len(box), i, k)
+        if best is None:
+            break
+        _, i, k = best
+        box = sorted(boxes[i], key=lambda c: c[k])
+        boxes[i:i + 1] = [box[:len(box) // 2], box[len(box) // 2:]]
+    # Snap to RGB565 so lv_color_make() reproduces the colour the error was measured on
+    means = [tuple(sum(c[k] for c in box) // len(box) for k in range(3)) for box in boxes]
+    return [rgb565_to_888((r >> 3) << 11 | (g >> 2) << 5 | b >> 3) for r, g, b in means]
+
+
+def encode_indexed8(pixels, width, height, dither=I8_DITHER):
+    """Return (LVGL indexed-8 data, PSNR in dB against the RGB565 source)."""
+    colors = [rgb565_to_888(p) for p in pixels]
+    palette = _median_cut(colors, 256)
+    palette += [(0, 0, 0)] * (256 - len(palette))
+
+    nearest = {}
+    indices = bytearray()
+    sse = 0
+    for y in range(height):
+        for x in range(width):
+            c = colors[y * width + x]
+            ofs = (BAYER8[y & 7][x & 7] - 31.5) * dither / 64
+            d = tuple(min(255, max(0, int(v + ofs))) for v in c)
+            i = nearest.get(d)
+            if i is None:
+                # Green weighs most, as in the eye
+                i = min(range(256), key=lambda j: 2 * (palette[j][0] - d[0]) ** 2 +
+                        4 * (palette[j][1] - d[1]) ** 2 + 3 * (palette[j][2] - d[2]) ** 2)
+                nearest[d] = i
+            indices.append(i)
+            sse += sum((palette[i][k] - c[k]) ** 2 for k in range(3))
+
+    data = bytearray()
+    for r, g, b in palette:
+        data += bytes([b, g, r, 0xFF])
+    data += indices
+    psnr = 10 * math.log10(255 * 255 * width * height * 3 / sse) if sse else float("inf")
+    return bytes(data), psnr
+
+
+# Watch faces: baseline JPEGs named face_<name>, decoded on the watch by the ROM TJpgDec
+# (src/WatchFace.cpp). Two tints of the photo ship by default; every baseline *.jpg
+# (copied as is) or P6 *.ppm (encoded here) of the panel size in assets/faces is added as well.
+FACE_PREFIX = "face_"
+FACE_DEFAULTS = screen_gen.read_defines(os.path.join(PROJECT_DIR, "include", "WatchFace.h"))
+JPEG_QUALITY = 85
+
+
+def _sepia(r, g, b):
+    return (min(255, int(0.393 * r + 0.769 * g + 0.189 * b)),
+            min(255, int(0.349 * r + 0.686 * g + 0.168 * b)),
+            min(255, int(0.272 * r + 0.534 * g + 0.131 * b)))
+
+
+def _night(r, g, b):
+    return int(0.35 * r), int(0.45 * g), min(255, int(0.7 * b) + 24)
+
+
+FACE_TINTS = [("sepia", _sepia), ("night", _night)]
+
+
+def build_faces(pixels, width, height):
+    """[(asset name, JPEG bytes, note)] for every face after the built-in photo."""
+    rgb = [rgb565_to_888(p) for p in pixels]
+    faces = [(FACE_PREFIX + name, jpeg_encode.encode([tint(*c) for c in rgb], width, height, JPEG_QUALITY),
+              "tinted photo, quality %d" % JPEG_QUALITY) for name, tint in FACE_TINTS]
+    if os.path.isdir(FACES_DIR):
+        for fname in sorted(os.listdir(FACES_DIR)):
+            stem, ext = os.path.splitext(fname)
+            path = os.path.join(FACES_DIR, fname)
+            if ext.lower() not in (".jpg", ".jpeg", ".ppm"):
+                continue
+            try:
+                if ext.lower() == ".ppm":
+                    px, w, h = jpeg_encode.read_ppm(path)
+                    blob = jpeg_encode.encode(px, w, h, JPEG_QUALITY)
+                else:
+                    with open(path, "rb") as f:
+                        blob = f.read()
+                    w, h = jpeg_encode.probe(blob)
+            except (IOError, ValueError) as e:
+                raise SystemExit("asset_pipeline: %s: %s" % (path, e))
+            if (w, h) != (width, height):
+                raise SystemExit("asset_pipeline: %s is %dx%d, faces must be %dx%d" % (path, w, h, width, height))
+            faces.append((FACE_PREFIX + stem.lower(), blob, "quality %d" % JPEG_QUALITY if ext.lower() == ".ppm" else "copied"))
+    return faces
+
+
+# ---------- Emitters ----------
+
+def _hex_rows(values, fmt, per_row):
+    rows = []
+    for i in range(0, len(values), per_row):
+        rows.append("  " + ", ".join(fmt % v for v in values[i:i + per_row]) + ",")
+    return "\n".join(rows)
+
+
+_written = set()
+
+
+def write_if_changed(path, text):
+    _written.add(os.path.abspath(path))
+    if os.path.exists(path):
+        with open(path) as f:
+            if f.read() == text:
+                return
+    with open(path, "w") as f:
+        f.write(text)
+
+
+def emit_background(out_dir, pixels, note):
+    text = "\n".join([
+        "#ifndef BG_IMAGE_H",
+        "#define BG_IMAGE_H",
+        "// Generated by tools/asset_pipeline.py - do not edit (%s)" % note,
+        "#include <lvgl.h>",
+        "#include <Arduino.h>",
+        "",
+        "const LV_ATTRIBUTE_MEM_ALIGN uint16_t my_image_map[] PROGMEM = {",
+        _hex_rows(pixels, "0x%04X", 16),
+        "};",
+        "",
+        "#endif // BG_IMAGE_H",
+        "",
+    ])
+    write_if_changed(os.path.join(out_dir, "bg_image.h"), text)
+
+
+def emit_background_q565(out_dir, blob, raw_size):
+    text = "\n".join([
+        "#ifndef BG_IMAGE_Q565_H",
+        "#define BG_IMAGE_Q565_H",
+        "// Generated by tools/asset_pipeline.py - do not edit (Q565, %d of %d bytes)"
+        % (len(blob), raw_size),
+        "#include <Arduino.h>",
+        "",
+        "const uint8_t bg_image_q565[] __attribute__((aligned(4))) = {",
+        _hex_rows(blob, "0x%02x", 24),
+        "};",
+        "",
+        "#endif // BG_IMAGE_Q565_H",
+        "",
+    ])
+    write_if_changed(os.path.join(out_dir, "bg_image_q565.h"), text)
+
+
+def emit_background_i8(out_dir, data, psnr):
+    text = "\n".join([
+        "#ifndef BG_IMAGE_I8_H",
+        "#define BG_IMAGE_I8_H",
+        "// Generated by tools/asset_pipeline.py - do not edit (indexed-8, dither %d, PSNR %.2f dB)"
+        % (I8_DITHER, psnr),
+        "#include <Arduino.h>",
+        "",
+        "const uint8_t bg_image_i8[] __attribute__((aligned(4))) = {",
+        _hex_rows(data, "0x%02x", 24),
+        "};",
+        "",
+        "#endif // BG_IMAGE_I8_H",
+        "",
+    ])
+    write_if_changed(os.path.join(out_dir, "bg_image_i8.h"), text)
+
+
+def emit_icon_atlas(out_dir, data, cf, bpp, tints, note):
+    text = "\n".join([
+        "#ifndef WEATHER_ICON_ATLAS_H",
+        "#define WEATHER_ICON_ATLAS_H",
+        "// Generated by tools/asset_pipeline.py - do not edit (%s)" % note,
+        "// Include from src/IconAtlas.cpp only: icons %s stacked top to bottom"
+        % ", ".join(ICON_NAMES),
+        "#include <lvgl.h>",
+        "",
+        "#define WEATHER_ICON_ATLAS_CF %s" % cf,
+        "#define WEATHER_ICON_ATLAS_BPP %d" % bpp,
+        "",
+        "static const uint8_t weather_icon_atlas[] __attribute__((aligned(4))) = {",
+        _hex_rows(data, "0x%02x", ICON_SIZE),
+        "};",
+        "",
+        "// Alpha-weighted mean colour of each icon, the recolour for A8 masks",
+        "static const uint32_t weather_icon_tint[] = {%s};" % ", ".join("0x%06X" % t for t in tints),
+        "",
+        "#endif // WEATHER_ICON_ATLAS_H",
+        "",
+    ])
+    write_if_changed(os.path.join(out_dir, "weather_icon_atlas.h"), text)
+
+
+def emit_fonts(out_dir, lvgl_dir, compress):
+    """watch_fonts.h (included by src/FontData.c) + watch_font_conf.h; returns the latter."""
+    font_dir = os.path.join(lvgl_dir, "src", "font")
+    try:
+        fonts, report = font_subset.build(font_dir, compress)
+    except (IOError, OSError, ValueError, AttributeError) as e:
+        raise SystemExit("asset_pipeline: cannot subset the LVGL fonts in %s (%s); "
+                         "build with WATCH_FONT_SUBSET=0 to use the full fonts" % (font_dir, e))
+    for line in report:
+        print("asset_pipeline: " + line)
+    write_if_changed(os.path.join(out_dir, "watch_fonts.h"), "\n".join(
+        ["/* Generated by tools/asset_pipeline.py from LVGL's Montserrat sources - do not edit.",
+         " * " + "\n * ".join(report),
+         " */", "", fonts]))
+
+    conf = ["/* Generated by tools/asset_pipeline.py - forced into every translation unit (-include) */",
+            "#define LV_FONT_DEFAULT &watch_font_14",
+            "#define LV_FONT_CUSTOM_DECLARE LV_FONT_DECLARE(watch_font_14)"]
+    if compress:
+        conf.append("#define LV_USE_FONT_COMPRESSED 1")
+    path = os.path.join(out_dir, "watch_font_conf.h")
+    write_if_changed(path, "\n".join(conf + [""]))
+    return path
+
+
+def emit_asset_pack(out_dir, assets, partitions_csv):
+    """Write assets.bin if it changed; returns its path."""
+    try:
+        image = asset_pack.pack(assets)
+        _, size = asset_pack.partition(partitions_csv)
+    except (IOError, ValueError) as e:
+        raise SystemExit("asset_pipeline: %s" % e)
+    if len(image) > size:
+        raise SystemExit("asset_pipeline: assets.bin is %d bytes, the assets partition in %s %d"
+                         % (len(image), os.path.basename(partitions_csv), size))
+    path = os.path.join(out_dir, "assets.bin")
+    if not os.path.exists(path) or open(path, "rb").read() != image:
+        with open(path, "wb") as f:
+            f.write(image)
+    return path
+
+
+# ---------- Driver ----------
+
+def generate(out_dir, defines, lvgl_dir=None, partitions_csv=PARTITIONS_CSV):
+    """Generate every asset variant selected by `defines` into `out_dir`.
+
+    Returns (header to force-include for the font subsets or None, assets.bin path).
+    """
+    if not os.path.isdir(out_dir):
+        os.makedirs(out_dir)
+
+    # Q565 is cheap and always available; the firmware only links the format it draws.
+    # Indexed-8 takes a few seconds of palette search, so only when it is used or benchmarked.
+    width = int(defines.get("TFT_WIDTH", BG_WIDTH))
+    height = int(defines.get("TFT_HEIGHT", BG_HEIGHT))
+    photo = load_background(width, height)
+    swap = int(defines.get("LV_COLOR_16_SWAP", 0))
+    raw = [swap16(p) for p in photo] if swap else photo
+    assets = [("bg_raw", "LV_IMG_CF_TRUE_COLOR", width, height, struct.pack("<%dH" % len(raw), *raw))]
+
+    q565 = encode_q565(photo, width, height)
+    emit_background_q565(out_dir, q565, width * height * 2)
+    assets.append(("bg_q565", "LV_IMG_CF_USER_ENCODED_0", width, height, q565))
+    if int(defines.get("WATCH_BG_FORMAT", 1)) == 2 or int(defines.get("DISPLAY_BENCH", 0)):
+        i8, psnr = encode_indexed8(photo, width, height)
+        emit_background_i8(out_dir, i8, psnr)
+        assets.append(("bg_i8", "LV_IMG_CF_INDEXED_8BIT", width, height, i8))
+
+    icons = load_icons()
+    atlas, cf, bpp, note = build_icon_atlas(icons, int(defines.get("WEATHER_ICON_FORMAT", ICON_FORMAT_OPAQUE)),
+                                            int(str(defines.get("WEATHER_ICON_BG", 0)), 0), swap)
+    emit_icon_atlas(out_dir, atlas, cf, bpp, [icon_tint(icons[n]) for n in ICON_NAMES],
+                    note + (", LV_COLOR_16_SWAP" if swap else ""))
+    assets.append(("weather_icons", cf, ICON_SIZE, ICON_SIZE * len(ICON_NAMES), atlas))
+
+    # JPEG faces exist only in the store: compiled in they would cost more flash than the photo.
+    # The watch decodes a face into one heap block; faces it cannot allocate are not packed.
+    cache_max = int(defines.get("WATCH_FACE_CACHE_MAX", FACE_DEFAULTS["WATCH_FACE_CACHE_MAX"]))
+    faces = int(defines.get("WATCH_FACES", 1)) and int(defines.get("WATCH_ASSET_STORE", 1))
+    if faces and width * height * 2 > cache_max:
+        print("asset_pipeline: faces skipped, a %dx%d face cache is %d bytes (WATCH_FACE_CACHE_MAX %d)"
+              % (width, height, width * height * 2, cache_max))
+        faces = False
+    if faces:
+        for name, blob, note in build_faces(photo, width, height):
+            print("asset_pipeline: %s %d bytes (%s)" % (name, len(blob), note))
+            assets.append((name, "LV_IMG_CF_RAW", width, height, blob))
+    pack = emit_asset_pack(out_dir, assets, partitions_csv)
+
+    # Always generated: they are small, and WATCH_SCREEN_GEN=0 simply does not include them
+    try:
+        screens = screen_gen.build(SCREENS_DIR, PROJECT_DIR, width, height)
+    except (IOError, ValueError, KeyError) as e:
+        raise SystemExit("asset_pipeline: screens/: %s" % e)
+    for name, text in screens:
+        write_if_changed(os.path.join(out_dir, name), text)
+
+    font_conf = None
+    if int(defines.get("WATCH_FONT_SUBSET", 0)):
+        if lvgl_dir:
+            font_conf = emit_fonts(out_dir, lvgl_dir, int(defines.get("WATCH_FONT_COMPRESSED", 0)))
+        else:
+            print("asset_pipeline: LVGL_DIR not set, fonts skipped")
+
+    scaled = (width, height) != (BG_WIDTH, BG_HEIGHT)
+    if swap or scaled:
+        # Panel byte order end to end (LVGL renders swapped) and panel size: the linked photo must match
+        notes = ["%dx%d scaled from %dx%d" % (width, height, BG_WIDTH, BG_HEIGHT)] * scaled + ["LV_COLOR_16_SWAP"] * swap
+        emit_background(out_dir, raw, ", ".join(notes))
+
+    # Drop variants from a previous configuration so include/ is used again
+    for name in os.listdir(out_dir):
+        path = os.path.abspath(os.path.join(out_dir, name))
+        if name.endswith(".h") and path not in _written:
+            os.remove(path)
+    return font_conf, pack
+
+
+# Functions that build the app screens, hand-written or generated (static, so possibly inlined)
+SCREEN_BUILDERS = re.compile(r"^(App\w+_Init|create_watch_face|screen_build_\w+)$")
+
+
+def report_screen_code(elf, nm):
+    """Print the flash size of every screen builder in the linked firmware."""
+    try:
+        out = subprocess.check_output([nm, "--print-size", "--size-sort", elf], universal_newlines=True)
+    except (OSError, subprocess.CalledProcessError) as e:
+        print("asset_pipeline: no code size report (%s)" % e)
+        return
+    total = 0
+    for line in out.splitlines():
+        cols = line.split()
+        if len(cols) == 4 and cols[2] in "tT" and SCREEN_BUILDERS.match(cols[3]):
+            size = int(cols[1], 16)
+            total += size
+            print("asset_pipeline: screen code %-22s %5d B" % (cols[3], size))
+    print("asset_pipeline: screen code total %d B" % total)
+
+
+def _env_defines(env):
+    # Pre-scripts run before build_flags are merged into CPPDEFINES, so parse both
+    items = list(env.get("CPPDEFINES", []))
+    items += env.ParseFlags(env.get("BUILD_FLAGS", [])).get("CPPDEFINES", [])
+    defines = {}
+    for item in items:
+        if isinstance(item, (list, tuple)):
+            defines[item[0]] = item[1] if len(item) > 1 else 1
+        else:
+            defines[item] = 1
+    return defines
+
+
+if __name__ == "__main__":
+    if len(sys.argv) < 2:
+        print(__doc__)
+        sys.exit(1)
+    generate(sys.argv[1], dict(arg.split("=", 1) for arg in sys.argv[2:]), os.environ.get("LVGL_DIR"),
+             os.path.join(PROJECT_DIR, os.environ.get("PARTITIONS", "partitions.csv")))
+else:
+    try:
+        Import("env")  # noqa: F821 - provided by PlatformIO/SCons
+    except NameError:
+        env = None  # Imported by a host test (test/test_q565.py): encoders only
+
+    if env is not None:
+        gen_dir = env.subst("$BUILD_DIR/generated")  # noqa: F821
+        lvgl_dir = env.subst("$PROJECT_LIBDEPS_DIR/$PIOENV/lvgl")  # noqa: F821
+        defines = _env_defines(env)  # noqa: F821
+        partitions_csv = os.path.join(PROJECT_DIR, env.GetProjectOption("board_build.partitions", "partitions.csv"))  # noqa: F821
+        font_conf, pack = generate(gen_dir, defines, lvgl_dir, partitions_csv)
+        env.Prepend(CPPPATH=[gen_dir])  # noqa: F821
+
+        def screen_code_size(source, target, env):
+            report_screen_code(target[0].get_abspath(), env.subst("$CC").replace("gcc", "nm"))
+
+        env.AddPostAction("$BUILD_DIR/${PROGNAME}.elf", screen_code_size)  # noqa: F821
+        if font_conf:
+            # LVGL's default font must be known inside the library build as well; a forced
+            # header avoids passing '&' and '()' through the shell in -D values
+            env.Append(CCFLAGS=["-include", font_conf])  # noqa: F821
+
+        if int(defines.get("WATCH_ASSET_STORE", 1)):
+            # Flashed with every upload; `pio run -t upload_assets` rewrites only the partition
+            offset = "0x%X" % asset_pack.partition(partitions_csv)[0]
+            env.Append(FLASH_EXTRA_IMAGES=[(offset, pack)])  # noqa: F821
+
+            def upload_assets(source, target, env):
+                port = env.subst("$UPLOAD_PORT")
+                return env.Execute(" ".join(["$PYTHONEXE", "$UPLOADER", "--chip", "esp32"] +
+                                            (["--port", port] if port else []) +
+                                            ["--baud", "$UPLOAD_SPEED", "write_flash", offset, pack]))
+
+            env.AddCustomTarget("upload_assets", None, upload_assets,  # noqa: F821
+                                title="Upload assets", description="Write assets.bin to the assets partition")
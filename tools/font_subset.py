@@ -0,0 +1,424 @@
+"""Glyph subsets of LVGL's built-in Montserrat fonts.
+
+Used by asset_pipeline.py. The LVGL library sources (src/font/lv_font_montserrat_NN.c, as
+written by lv_font_conv with --no-compress --force-fast-kern-format) are parsed and only the
+glyphs in FONT_SUBSETS are kept: cmaps, glyph ids and kerning classes are rebuilt around
+them. Bitmaps can optionally be re-encoded in LVGL's compressed format (RLE + line XOR
+prefilter, LV_FONT_FMT_TXT_COMPRESSED, needs LV_USE_FONT_COMPRESSED).
+
+Host use, prints the size report:
+    python tools/font_subset.py <lvgl>/src/font [--compress]
+"""
+
+import os
+import re
+import sys
+
+ASCII = "".join(chr(c) for c in range(0x20, 0x7F))
+
+# LV_SYMBOL_* glyphs the apps put in 14 px status lines
+SYMBOLS_14 = [
+    0xF00C,  # LV_SYMBOL_OK
+    0xF04B,  # LV_SYMBOL_PLAY
+    0xF04C,  # LV_SYMBOL_PAUSE
+    0xF053,  # LV_SYMBOL_LEFT
+    0xF054,  # LV_SYMBOL_RIGHT
+    0xF071,  # LV_SYMBOL_WARNING
+    0xF077,  # LV_SYMBOL_UP
+    0xF078,  # LV_SYMBOL_DOWN
+]
+
+# Glyphs per size, from the label texts in src/
+FONT_SUBSETS = {
+    # Dates, scores, weather values and status lines: any ASCII plus the symbols above
+    14: [ord(c) for c in ASCII] + [0xB0] + SYMBOLS_14,
+    # Clock, titles (SNAKE, BREAKOUT, TIMER) and temperatures ("-3.5°C")
+    24: [ord(c) for c in " -.0123456789:ABCDEFGHIJKLMNOPQRSTUVWXYZ°"],
+    # Timer and always-on clock ("--:--" before NTP)
+    48: [ord(c) for c in "-0123456789:"],
+}
+
+GLYPH_DSC_BYTES = 8  # lv_font_fmt_txt_glyph_dsc_t
+CMAP_BYTES = 20      # lv_font_fmt_txt_cmap_t
+
+
+# ---------- Parsing ----------
+
+def _array(text, name):
+    m = re.search(r"\b%s\[\]\s*=\s*\{(.*?)\};" % re.escape(name), text, flags=re.S)
+    if not m:
+        raise ValueError("%s[] not found" % name)
+    body = re.sub(r"/\*.*?\*/", "", m.group(1), flags=re.S)
+    return [int(tok, 0) for tok in re.findall(r"-?(?:0x[0-9A-Fa-f]+|\d+)", body)]
+
+
+def _field(text, name):
+    m = re.search(r"\.%s\s*=\s*(-?\w+)" % re.escape(name), text)
+    if not m:
+        raise ValueError(".%s not found" % name)
+    return m.group(1)
+
+
+def parse_font(path):
+    """Return {'glyphs': {unicode: glyph}, 'kern': ..., metrics} for an lv_font_conv C file."""
+    with open(path) as f:
+        text = f.read()
+
+    bitmap = _array(text, "glyph_bitmap")
+    dsc = [dict(zip(("bitmap_index", "adv_w", "box_w", "box_h", "ofs_x", "ofs_y"), map(int, m)))
+           for m in re.findall(r"\{\.bitmap_index = (\d+), \.adv_w = (\d+), \.box_w = (\d+), "
+                               r"\.box_h = (\d+), \.ofs_x = (-?\d+), \.ofs_y = (-?\d+)\}", text)]
+    if int(_field(text, "bitmap_format")) != 0:
+        raise ValueError("%s: only plain (uncompressed) bitmaps can be subset" % path)
+    bpp = int(_field(text, "bpp"))
+
+    # glyph id -> unicode from the cmaps
+    unicode_of = {}
+    cmaps = re.search(r"lv_font_fmt_txt_cmap_t cmaps\[\]\s*=\s*\{(.*?)\n\};", text, flags=re.S).group(1)
+    for m in re.finditer(r"\{(.*?)\}", cmaps, flags=re.S):
+        c = m.group(1)
+        start, gid = int(_field(c, "range_start")), int(_field(c, "glyph_id_start"))
+        length, kind = int(_field(c, "range_length")), _field(c, "type")
+        ulist = _field(c, "unicode_list")
+        if _field(c, "glyph_id_ofs_list") != "NULL":
+            raise ValueError("%s: cmaps with glyph_id_ofs_list are not supported" % path)
+        if kind == "LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY":
+            for i in range(length):
+                unicode_of[gid + i] = start + i
+        elif kind == "LV_FONT_FMT_TXT_CMAP_SPARSE_TINY":
+            for i, ofs in enumerate(_array(text, ulist)):
+                unicode_of[gid + i] = start + ofs
+        else:
+            raise ValueError("%s: cmap type %s is not supported" % (path, kind))
+
+    # Bitmaps are byte aligned per glyph and packed continuously inside it
+    glyphs = {}
+    for gid, u in unicode_of.items():
+        d = dict(dsc[gid])
+        size = (d["box_w"] * d["box_h"] * bpp + 7) // 8
+        d["bitmap"] = bitmap[d["bitmap_index"]:d["bitmap_index"] + size]
+        d["gid"] = gid
+        glyphs[u] = d
+
+    kern = None
+    if re.search(r"\.kern_classes\s*=\s*1", text):
+        kern = {
+            "left": _array(text, "kern_left_class_mapping"),
+            "right": _array(text, "kern_right_class_mapping"),
+            "values": _array(text, "kern_class_values"),
+            "left_cnt": int(_field(text, "left_class_cnt")),
+            "right_cnt": int(_field(text, "right_class_cnt")),
+        }
+    elif "kern_pair_glyph_ids" in text:
+        raise ValueError("%s: pair kerning is not supported, regenerate with --force-fast-kern-format" % path)
+
+    return {
+        "glyphs": glyphs,
+        "bpp": bpp,
+        "kern": kern,
+        "kern_scale": int(_field(text, "kern_scale")),
+        "line_height": int(_field(text, "line_height")),
+        "base_line": int(_field(text, "base_line")),
+        "underline_position": int(_field(text, "underline_position")),
+        "underline_thickness": int(_field(text, "underline_thickness")),
+        "bitmap_bytes": len(bitmap),
+        "glyph_count": len(dsc) - 1,
+        "cmap_count": len(re.findall(r"\.range_start", cmaps)),
+        "unicode_list_len": sum(len(_array(text, n)) for n in set(re.findall(r"\bunicode_list_\d+\b", text))),
+    }
+
+
+# ---------- Compression ----------
+
+def _pixels(bitmap, count, bpp):
+    mask = (1 << bpp) - 1
+    return [(bitmap[(i * bpp) // 8] >> (8 - bpp - (i * bpp) % 8)) & mask for i in range(count)]
+
+
+class _BitWriter:
+    def __init__(self):
+        self.bits = []
+
+    def put(self, value, width):
+        self.bits += [(value >> (width - 1 - i)) & 1 for i in range(width)]
+
+    def data(self):
+        bits = self.bits + [0] * (-len(self.bits) % 8)
+        return [int("".join(map(str, bits[i:i + 8])), 2) for i in range(0, len(bits), 8)]
+
+
+def compress_glyph(bitmap, w, h, bpp):
+    """LVGL RLE with prefilter; mirrors rle_next()/decompress() in lv_font_fmt_txt.c."""
+    px = _pixels(bitmap, w * h, bpp)
+    vals = px[:w] + [px[i] ^ px[i - w] for i in range(w, w * h)]
+    out = _BitWriter()
+    i, n = 0, len(vals)
+    repeating, prev, cnt = False, None, 0
+    while i < n:
+        v = vals[i]
+        if not repeating:
+            out.put(v, bpp)
+            repeating = i > 0 and v == prev
+            cnt = 0
+            prev = v
+            i += 1
+        elif v != prev:
+            out.put(0, 1)
+            out.put(v, bpp)
+            repeating, prev = False, v
+            i += 1
+        elif cnt < 10:
+            out.put(1, 1)
+            cnt += 1
+            i += 1
+        else:
+            # 11th repeat switches to a 6-bit counter: c repeats, then a literal
+            out.put(1, 1)
+            run = 0
+            while i + run < n and vals[i + run] == prev and run < 63:
+                run += 1
+            out.put(run, 6)
+            i += run
+            if i < n:
+                out.put(vals[i], bpp)
+                prev = vals[i]
+                i += 1
+            repeating = False
+    return out.data()
+
+
+def decompress_glyph(data, w, h, bpp):
+    """Python port of LVGL's decompress(), for checking compress_glyph()."""
+    pos = [0]
+
+    def bits(width):
+        v = 0
+        for _ in range(width):
+            v = (v << 1) | ((data[pos[0] >> 3] >> (7 - (pos[0] & 7))) & 1 if (pos[0] >> 3) < len(data) else 0)
+            pos[0] += 1
+        return v
+
+    state, prev, cnt, out = "single", 0, 0, []
+    for _ in range(w * h):
+        if state == "single":
+            ret = bits(bpp)
+            if pos[0] != bpp and prev == ret:
+                cnt, state = 0, "repeat"
+            prev = ret
+        elif state == "repeat":
+            v = bits(1)
+            cnt += 1
+            if v:
+                ret = prev
+                if cnt == 11:
+                    cnt = bits(6)
+                    if cnt:
+                        state = "counter"
+                    else:
+                        ret = prev = bits(bpp)
+                        state = "single"
+            else:
+                ret = prev = bits(bpp)
+                state = "single"
+        else:
+            ret = prev
+            cnt -= 1
+            if cnt == 0:
+                ret = prev = bits(bpp)
+                state = "single"
+        out.append(ret)
+    for i in range(w, w * h):
+        out[i] ^= out[i - w]
+    return out
+
+
+# ---------- Subsetting ----------
+
+def subset_font(font, codepoints, compress=False):
+    """Return the data of a font holding only `codepoints` that exist in `font`."""
+    cps = sorted(set(c for c in codepoints if c in font["glyphs"]))
+    missing = sorted(set(codepoints) - set(cps))
+    if missing:
+        raise ValueError("glyphs missing from the source font: %s" % ", ".join("U+%04X" % c for c in missing))
+
+    # Runs of 3+ consecutive code points become FORMAT0_TINY ranges; the rest one sparse
+    # list at the end (LVGL stops at the first cmap whose range holds the letter)
+    runs, sparse = [], []
+    for c in cps:
+        if runs and runs[-1][-1] == c - 1:
+            runs[-1].append(c)
+        else:
+            runs.append([c])
+    ranges = [r for r in runs if len(r) >= 3]
+    for r in runs:
+        if len(r) < 3:
+            sparse += r
+    order = [c for r in ranges for c in r] + sparse
+
+    bpp = font["bpp"]
+    bitmap, dsc = [], []
+    for c in order:
+        g = font["glyphs"][c]
+        data = g["bitmap"]
+        if compress and g["box_w"] and g["box_h"]:
+            data = compress_glyph(data, g["box_w"], g["box_h"], bpp)
+            check = decompress_glyph(data, g["box_w"], g["box_h"], bpp)
+            if check != _pixels(g["bitmap"], g["box_w"] * g["box_h"], bpp):
+                raise ValueError("compression round trip failed for U+%04X" % c)
+        dsc.append(dict(g, bitmap_index=len(bitmap)))
+        bitmap += data
+
+    cmaps, gid = [], 1
+    for r in ranges:
+        cmaps.append({"start": r[0], "length": len(r), "gid": gid, "list": None})
+        gid += len(r)
+    if sparse:
+        cmaps.append({"start": sparse[0], "length": sparse[-1] - sparse[0] + 1, "gid": gid,
+                      "list": [c - sparse[0] for c in sparse]})
+
+    kern = None
+    if font["kern"]:
+        k = font["kern"]
+        # Keep only classes that a kept glyph belongs to, renumbered from 1
+        left_used = sorted(set(k["left"][font["glyphs"][c]["gid"]] for c in order) - {0})
+        right_used = sorted(set(k["right"][font["glyphs"][c]["gid"]] for c in order) - {0})
+        lmap = {old: i + 1 for i, old in enumerate(left_used)}
+        rmap = {old: i + 1 for i, old in enumerate(right_used)}
+        kern = {
+            "left": [0] + [lmap.get(k["left"][font["glyphs"][c]["gid"]], 0) for c in order],
+            "right": [0] + [rmap.get(k["right"][font["glyphs"][c]["gid"]], 0) for c in order],
+            "values": [k["values"][(l - 1) * k["right_cnt"] + (r - 1)] for l in left_used for r in right_used],
+            "left_cnt": len(left_used),
+            "right_cnt": len(right_used),
+        }
+
+    return {"bitmap": bitmap, "dsc": dsc, "cmaps": cmaps, "kern": kern, "compressed": compress,
+            "font": font}
+
+
+def font_bytes(bitmap_bytes, glyphs, cmaps, ulist, kern):
+    """Approximate flash footprint of an lv_font_fmt_txt font."""
+    size = bitmap_bytes + (glyphs + 1) * GLYPH_DSC_BYTES + cmaps * CMAP_BYTES + ulist * 2
+    if kern:
+        size += 2 * (glyphs + 1) + kern["left_cnt"] * kern["right_cnt"]
+    return size
+
+
+def source_bytes(font):
+    return font_bytes(font["bitmap_bytes"], font["glyph_count"], font["cmap_count"],
+                      font["unicode_list_len"], font["kern"])
+
+
+def subset_bytes(sub):
+    ulist = sum(len(c["list"]) for c in sub["cmaps"] if c["list"])
+    return font_bytes(len(sub["bitmap"]), len(sub["dsc"]), len(sub["cmaps"]), ulist, sub["kern"])
+
+
+# ---------- Emitting ----------
+
+def _rows(values, fmt, per_row=16):
+    return "\n".join("    " + ", ".join(fmt % v for v in values[i:i + per_row]) + ","
+                     for i in range(0, len(values), per_row))
+
+
+def emit_font(name, sub):
+    """C source (for a .c translation unit) defining `const lv_font_t name`."""
+    f = sub["font"]
+    p = name + "_"
+    out = [
+        "/* %s: %d glyphs, %s bitmaps */" % (name, len(sub["dsc"]), "compressed" if sub["compressed"] else "plain"),
+        "static LV_ATTRIBUTE_LARGE_CONST const uint8_t %sglyph_bitmap[] = {" % p,
+        _rows(sub["bitmap"], "0x%02x") if sub["bitmap"] else "    0x00,",
+        "};",
+        "",
+        "static const lv_font_fmt_txt_glyph_dsc_t %sglyph_dsc[] = {" % p,
+        "    {.bitmap_index = 0, .adv_w = 0, .box_w = 0, .box_h = 0, .ofs_x = 0, .ofs_y = 0} /* id = 0 reserved */,",
+    ]
+    for d in sub["dsc"]:
+        out.append("    {.bitmap_index = %d, .adv_w = %d, .box_w = %d, .box_h = %d, .ofs_x = %d, .ofs_y = %d},"
+                   % (d["bitmap_index"], d["adv_w"], d["box_w"], d["box_h"], d["ofs_x"], d["ofs_y"]))
+    out += ["};", ""]
+
+    for i, c in enumerate(sub["cmaps"]):
+        if c["list"]:
+            out += ["static const uint16_t %sunicode_list_%d[] = {" % (p, i), _rows(c["list"], "0x%x"), "};", ""]
+    out.append("static const lv_font_fmt_txt_cmap_t %scmaps[] = {" % p)
+    for i, c in enumerate(sub["cmaps"]):
+        if c["list"]:
+            out.append("    {.range_start = %d, .range_length = %d, .glyph_id_start = %d, .unicode_list = "
+                       "%sunicode_list_%d, .glyph_id_ofs_list = NULL, .list_length = %d, .type = "
+                       "LV_FONT_FMT_TXT_CMAP_SPARSE_TINY}," % (c["start"], c["length"], c["gid"], p, i, len(c["list"])))
+        else:
+            out.append("    {.range_start = %d, .range_length = %d, .glyph_id_start = %d, .unicode_list = NULL, "
+                       ".glyph_id_ofs_list = NULL, .list_length = 0, .type = LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY},"
+                       % (c["start"], c["length"], c["gid"]))
+    out += ["};", ""]
+
+    k = sub["kern"]
+    if k:
+        out += [
+            "static const uint8_t %skern_left_class_mapping[] = {" % p, _rows(k["left"], "%d", 24), "};",
+            "static const uint8_t %skern_right_class_mapping[] = {" % p, _rows(k["right"], "%d", 24), "};",
+            "static const int8_t %skern_class_values[] = {" % p,
+            _rows(k["values"], "%d", 24) if k["values"] else "    0,", "};",
+            "static const lv_font_fmt_txt_kern_classes_t %skern_classes = {" % p,
+            "    .class_pair_values = %skern_class_values," % p,
+            "    .left_class_mapping = %skern_left_class_mapping," % p,
+            "    .right_class_mapping = %skern_right_class_mapping," % p,
+            "    .left_class_cnt = %d," % k["left_cnt"],
+            "    .right_class_cnt = %d," % k["right_cnt"],
+            "};",
+            "",
+        ]
+
+    out += [
+        "static lv_font_fmt_txt_glyph_cache_t %scache;" % p,
+        "static const lv_font_fmt_txt_dsc_t %sfont_dsc = {" % p,
+        "    .glyph_bitmap = %sglyph_bitmap," % p,
+        "    .glyph_dsc = %sglyph_dsc," % p,
+        "    .cmaps = %scmaps," % p,
+        "    .kern_dsc = %s," % ("&%skern_classes" % p if k else "NULL"),
+        "    .kern_scale = %d," % f["kern_scale"],
+        "    .cmap_num = %d," % len(sub["cmaps"]),
+        "    .bpp = %d," % f["bpp"],
+        "    .kern_classes = %d," % (1 if k else 0),
+        "    .bitmap_format = %s," % ("LV_FONT_FMT_TXT_COMPRESSED" if sub["compressed"] else "LV_FONT_FMT_TXT_PLAIN"),
+        "    .cache = &%scache," % p,
+        "};",
+        "",
+        "const lv_font_t %s = {" % name,
+        "    .get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt,",
+        "    .get_glyph_bitmap = lv_font_get_bitmap_fmt_txt,",
+        "    .line_height = %d," % f["line_height"],
+        "    .base_line = %d," % f["base_line"],
+        "    .subpx = LV_FONT_SUBPX_NONE,",
+        "    .underline_position = %d," % f["underline_position"],
+        "    .underline_thickness = %d," % f["underline_thickness"],
+        "    .dsc = &%sfont_dsc," % p,
+        "};",
+        "",
+    ]
+    return "\n".join(out)
+
+
+def build(font_dir, compress=False, prefix="watch_font_"):
+    """Return (C text for all subsets, report lines)."""
+    parts, report = [], []
+    for size in sorted(FONT_SUBSETS):
+        src = os.path.join(font_dir, "lv_font_montserrat_%d.c" % size)
+        font = parse_font(src)
+        sub = subset_font(font, FONT_SUBSETS[size], compress)
+        parts.append(emit_font("%s%d" % (prefix, size), sub))
+        before, after = source_bytes(font), subset_bytes(sub)
+        report.append("montserrat_%d: %d -> %d glyphs, %d -> %d bytes (-%d, %d%%)%s"
+                      % (size, font["glyph_count"], len(sub["dsc"]), before, after, before - after,
+                         100 * (before - after) // before, ", compressed" if compress else ""))
+    return "\n".join(parts), report
+
+
+if __name__ == "__main__":
+    if len(sys.argv) < 2:
+        print(__doc__)
+        sys.exit(1)
+    for line in build(sys.argv[1], "--compress" in sys.argv)[1]:
+        print(line)
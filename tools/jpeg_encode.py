@@ -0,0 +1,261 @@
+"""Baseline JPEG encoder for the watch faces (the build environment has no Pillow).
+
+Writes sequential baseline JFIF with the Annex K quantisation and Huffman tables,
+4:2:0 or 4:4:4 and no restart markers - the subset the ESP32 ROM TJpgDec decodes
+(src/WatchFace.cpp). probe() checks that a JPEG dropped into assets/faces is of that kind.
+
+    python tools/jpeg_encode.py <in.ppm> <out.jpg> [quality]
+"""
+
+import math
+import struct
+import sys
+
+ZIGZAG = [
+    0, 1, 8, 16, 9, 2, 3, 10, 17, 24, 32, 25, 18, 11, 4, 5,
+    12, 19, 26, 33, 40, 48, 41, 34, 27, 20, 13, 6, 7, 14, 21, 28,
+    35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23, 30, 37, 44, 51,
+    58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63,
+]
+
+# Annex K.1, natural order
+LUMA_Q = [
+    16, 11, 10, 16, 24, 40, 51, 61, 12, 12, 14, 19, 26, 58, 60, 55,
+    14, 13, 16, 24, 40, 57, 69, 56, 14, 17, 22, 29, 51, 87, 80, 62,
+    18, 22, 37, 56, 68, 109, 103, 77, 24, 35, 55, 64, 81, 104, 113, 92,
+    49, 64, 78, 87, 103, 121, 120, 101, 72, 92, 95, 98, 112, 100, 103, 99,
+]
+CHROMA_Q = [
+    17, 18, 24, 47, 99, 99, 99, 99, 18, 21, 26, 66, 99, 99, 99, 99,
+    24, 26, 56, 99, 99, 99, 99, 99, 47, 66, 99, 99, 99, 99, 99, 99,
+] + [99] * 32
+
+
+def _run(first, last):
+    return list(range(first, last + 1))
+
+
+# Annex K.3: (code length counts 1..16, symbols)
+DC_LUMA = ([0, 1, 5, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0], _run(0, 11))
+DC_CHROMA = ([0, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0], _run(0, 11))
+AC_LUMA = ([0, 2, 1, 3, 3, 2, 4, 3, 5, 5, 4, 4, 0, 0, 1, 0x7D], [
+    0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21, 0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07,
+    0x22, 0x71, 0x14, 0x32, 0x81, 0x91, 0xA1, 0x08, 0x23, 0x42, 0xB1, 0xC1, 0x15, 0x52, 0xD1, 0xF0,
+    0x24, 0x33, 0x62, 0x72, 0x82, 0x09, 0x0A, 0x16, 0x17, 0x18, 0x19, 0x1A] +
+    _run(0x25, 0x2A) + _run(0x34, 0x3A) + _run(0x43, 0x4A) + _run(0x53, 0x5A) + _run(0x63, 0x6A) +
+    _run(0x73, 0x7A) + _run(0x83, 0x8A) + _run(0x92, 0x9A) + _run(0xA2, 0xAA) + _run(0xB2, 0xBA) +
+    _run(0xC2, 0xCA) + _run(0xD2, 0xDA) + _run(0xE1, 0xEA) + _run(0xF1, 0xFA))
+AC_CHROMA = ([0, 2, 1, 2, 4, 4, 3, 4, 7, 5, 4, 4, 0, 1, 2, 0x77], [
+    0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31, 0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71,
+    0x13, 0x22, 0x32, 0x81, 0x08, 0x14, 0x42, 0x91, 0xA1, 0xB1, 0xC1, 0x09, 0x23, 0x33, 0x52, 0xF0,
+    0x15, 0x62, 0x72, 0xD1, 0x0A, 0x16, 0x24, 0x34, 0xE1, 0x25, 0xF1, 0x17, 0x18, 0x19, 0x1A, 0x26] +
+    _run(0x27, 0x2A) + _run(0x35, 0x3A) + _run(0x43, 0x4A) + _run(0x53, 0x5A) + _run(0x63, 0x6A) +
+    _run(0x73, 0x7A) + _run(0x82, 0x8A) + _run(0x92, 0x9A) + _run(0xA2, 0xAA) + _run(0xB2, 0xBA) +
+    _run(0xC2, 0xCA) + _run(0xD2, 0xDA) + _run(0xE2, 0xEA) + _run(0xF2, 0xFA))
+
+_COS = [[math.cos((2 * x + 1) * u * math.pi / 16) * (math.sqrt(0.5) if u == 0 else 1) / 2
+         for x in range(8)] for u in range(8)]
+
+
+def _scaled_table(table, quality):
+    # IJG quality scaling
+    quality = min(100, max(1, quality))
+    scale = 5000 // quality if quality < 50 else 200 - 2 * quality
+    return [min(255, max(1, (q * scale + 50) // 100)) for q in table]
+
+
+def _huffman_codes(spec):
+    bits, values = spec
+    codes, code, k = {}, 0, 0
+    for length in range(1, 17):
+        for _ in range(bits[length - 1]):
+            codes[values[k]] = (code, length)
+            code += 1
+            k += 1
+        code <<= 1
+    return codes
+
+
+class _BitWriter:
+    def __init__(self):
+        self.out = bytearray()
+        self.acc = 0
+        self.n = 0
+
+    def write(self, value, length):
+        self.acc = (self.acc << length) | (value & ((1 << length) - 1))
+        self.n += length
+        while self.n >= 8:
+            self.n -= 8
+            byte = (self.acc >> self.n) & 0xFF
+            self.out.append(byte)
+            if byte == 0xFF:
+                self.out.append(0)  # Byte stuffing
+        self.acc &= (1 << self.n) - 1
+
+    def flush(self):
+        if self.n:
+            self.write(0x7F, 8 - self.n)  # Pad with 1 bits
+
+
+def _fdct(block):
+    """8x8 level-shifted samples (row major) -> coefficients (row major)."""
+    rows = [[sum(_COS[u][x] * block[y * 8 + x] for x in range(8)) for u in range(8)] for y in range(8)]
+    return [sum(_COS[v][y] * rows[y][u] for y in range(8)) for v in range(8) for u in range(8)]
+
+
+def _magnitude(value):
+    size = abs(value).bit_length()
+    return size, value if value >= 0 else value + (1 << size) - 1
+
+
+def _encode_block(bits, block, qtable, prev_dc, dc_codes, ac_codes):
+    coef = _fdct(block)
+    zz = [int(round(coef[ZIGZAG[i]] / qtable[ZIGZAG[i]])) for i in range(64)]
+    size, value = _magnitude(zz[0] - prev_dc)
+    bits.write(*dc_codes[size])
+    bits.write(value, size)
+    run = 0
+    for ac in zz[1:]:
+        if ac == 0:
+            run += 1
+            continue
+        while run > 15:
+            bits.write(*ac_codes[0xF0])  # ZRL
+            run -= 16
+        size, value = _magnitude(ac)
+        bits.write(*ac_codes[(run << 4) | size])
+        bits.write(value, size)
+        run = 0
+    if run:
+        bits.write(*ac_codes[0x00])  # EOB
+    return zz[0]
+
+
+def _plane(rgb, width, height, pad_w, pad_h, channel):
+    """One YCbCr plane, edge-replicated to pad_w x pad_h, level shifted."""
+    plane = []
+    for y in range(pad_h):
+        row = rgb[min(y, height - 1) * width:(min(y, height - 1) + 1) * width]
+        for x in range(pad_w):
+            r, g, b = row[min(x, width - 1)]
+            if channel == 0:
+                plane.append(0.299 * r + 0.587 * g + 0.114 * b - 128)
+            elif channel == 1:
+                plane.append(-0.168736 * r - 0.331264 * g + 0.5 * b)
+            else:
+                plane.append(0.5 * r - 0.418688 * g - 0.081312 * b)
+    return plane
+
+
+def _downsample(plane, w, h):
+    return [(plane[2 * y * w + 2 * x] + plane[2 * y * w + 2 * x + 1] +
+             plane[(2 * y + 1) * w + 2 * x] + plane[(2 * y + 1) * w + 2 * x + 1]) / 4
+            for y in range(h // 2) for x in range(w // 2)]
+
+
+def _block(plane, w, bx, by):
+    return [plane[(by * 8 + y) * w + bx * 8 + x] for y in range(8) for x in range(8)]
+
+
+def _segment(marker, payload):
+    return struct.pack(">BBH", 0xFF, marker, len(payload) + 2) + payload
+
+
+def _dht(cls_id, spec):
+    bits, values = spec
+    return _segment(0xC4, bytes([cls_id] + bits + values))
+
+
+def encode(rgb, width, height, quality=85, subsample=True):
+    """rgb: width * height (r, g, b) tuples, row major. Returns the JPEG file bytes."""
+    mcu = 16 if subsample else 8
+    pad_w = (width + mcu - 1) // mcu * mcu
+    pad_h = (height + mcu - 1) // mcu * mcu
+    lq, cq = _scaled_table(LUMA_Q, quality), _scaled_table(CHROMA_Q, quality)
+
+    planes = [_plane(rgb, width, height, pad_w, pad_h, c) for c in range(3)]
+    cw, ch = pad_w, pad_h
+    if subsample:
+        planes[1:] = [_downsample(p, pad_w, pad_h) for p in planes[1:]]
+        cw, ch = pad_w // 2, pad_h // 2
+
+    codes = [(_huffman_codes(DC_LUMA), _huffman_codes(AC_LUMA)),
+             (_huffman_codes(DC_CHROMA), _huffman_codes(AC_CHROMA))]
+    bits = _BitWriter()
+    dc = [0, 0, 0]
+    ys = mcu // 8  # Luma blocks per MCU side
+    for my in range(pad_h // mcu):
+        for mx in range(pad_w // mcu):
+            for by in range(ys):
+                for bx in range(ys):
+                    dc[0] = _encode_block(bits, _block(planes[0], pad_w, mx * ys + bx, my * ys + by),
+                                          lq, dc[0], *codes[0])
+            for c in (1, 2):
+                dc[c] = _encode_block(bits, _block(planes[c], cw, mx, my), cq, dc[c], *codes[1])
+    bits.flush()
+
+    sampling = 0x22 if subsample else 0x11
+    out = bytearray(b"\xFF\xD8")
+    out += _segment(0xE0, b"JFIF\0\x01\x01\x00\x00\x01\x00\x01\x00\x00")
+    out += _segment(0xDB, bytes([0] + [lq[z] for z in ZIGZAG] + [1] + [cq[z] for z in ZIGZAG]))
+    out += _segment(0xC0, struct.pack(">BHHB", 8, height, width, 3) +
+                    bytes([1, sampling, 0, 2, 0x11, 1, 3, 0x11, 1]))
+    out += _dht(0x00, DC_LUMA) + _dht(0x10, AC_LUMA) + _dht(0x01, DC_CHROMA) + _dht(0x11, AC_CHROMA)
+    out += _segment(0xDA, bytes([3, 1, 0x00, 2, 0x11, 3, 0x11, 0, 63, 0]))
+    out += bits.out
+    out += b"\xFF\xD9"
+    return bytes(out)
+
+
+def probe(blob):
+    """(width, height) of a baseline JPEG; ValueError for progressive/other kinds."""
+    if blob[:2] != b"\xFF\xD8":
+        raise ValueError("not a JPEG")
+    pos = 2
+    while pos + 4 <= len(blob):
+        if blob[pos] != 0xFF:
+            raise ValueError("corrupt marker at %d" % pos)
+        marker = blob[pos + 1]
+        length = struct.unpack_from(">H", blob, pos + 2)[0]
+        if marker == 0xC0:
+            _, height, width, comps = struct.unpack_from(">BHHB", blob, pos + 4)
+            if comps not in (1, 3):
+                raise ValueError("%d components" % comps)
+            return width, height
+        if 0xC1 <= marker <= 0xCF and marker not in (0xC4, 0xC8, 0xCC):
+            raise ValueError("not baseline (SOF%d)" % (marker - 0xC0))
+        pos += 2 + length
+    raise ValueError("no frame header")
+
+
+def read_ppm(path):
+    """(rgb tuples, width, height) of a binary P6 file with maxval 255."""
+    with open(path, "rb") as f:
+        data = f.read()
+    fields, pos = [], 0
+    while len(fields) < 4:
+        while data[pos:pos + 1].isspace():
+            pos += 1
+        if data[pos:pos + 1] == b"#":
+            pos = data.index(b"\n", pos)
+            continue
+        end = pos
+        while not data[end:end + 1].isspace():
+            end += 1
+        fields.append(data[pos:end])
+        pos = end
+    if fields[0] != b"P6" or fields[3] != b"255":
+        raise ValueError("%s: only binary P6 with maxval 255" % path)
+    width, height = int(fields[1]), int(fields[2])
+    px = data[pos + 1:pos + 1 + width * height * 3]
+    return [tuple(px[i:i + 3]) for i in range(0, len(px), 3)], width, height
+
+
+if __name__ == "__main__":
+    if len(sys.argv) < 3:
+        print(__doc__)
+        sys.exit(1)
+    pixels, w, h = read_ppm(sys.argv[1])
+    with open(sys.argv[2], "wb") as f:
+        f.write(encode(pixels, w, h, int(sys.argv[3]) if len(sys.argv) > 3 else 85))
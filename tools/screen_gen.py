@@ -0,0 +1,241 @@
+"""Screen builder generator: screens/*.json -> screen_<name>.h (see asset_pipeline.py).
+
+A screen file describes the static widget tree of one app screen; the generated header
+holds `static void screen_build_<name>()`, which the app includes after its object
+pointers and calls from its Init (WATCH_SCREEN_GEN). Compared with the hand-written
+builders the generated code
+  - takes every geometry constant from the app source (#define NAME <integer expr>, which
+    may use DISPLAY_WIDTH / DISPLAY_HEIGHT of the panel being built for) and resolves
+    alignments of fixed-size widgets to plain lv_obj_set_pos calls,
+  - attaches the shared Theme styles instead of local properties,
+  - sets and clears each object's flags in one call.
+
+Screen file:
+    {"name": "snake", "source": "src/AppSnake.cpp",
+     "screen": {"ref": "snake_screen", "bg": "0x0a0a0a"},
+     "widgets": [widget, ...]}
+Widget keys (all optional except "type"):
+    type         sprite | label | bar | icon | digits
+    ref          app variable the object is stored in ("bricks[row][col]" inside repeat)
+    style        ThemeStyle (C expression, may use repeat indices)
+    size, pos    [w, h] / [x, y], integers or expressions over the source #defines
+    align        [LV_ALIGN_* suffix, x, y]; pre-resolved when size and parent are known
+    align_to     [ref, LV_ALIGN_* suffix, x, y]
+    text, color  label/digits text ({OK} = LV_SYMBOL_OK) and text colour (0xRRGGBB or a C expression)
+    bg_color, border_color       local colours for sprites and bars
+    indicator_color, value       bar
+    icon         WeatherIcon for "icon", font for "digits"
+    hidden       created hidden
+    repeat       count or [rows, cols]; "index" names the loop variables (default i / row, col)
+    children     nested widgets
+"""
+
+import json
+import os
+import re
+
+ALIGNS = ["TOP_LEFT", "TOP_MID", "TOP_RIGHT", "LEFT_MID", "CENTER", "RIGHT_MID",
+          "BOTTOM_LEFT", "BOTTOM_MID", "BOTTOM_RIGHT"]
+FRAME_BORDER = {"THEME_FRAME": 2}  # Border width of the Theme styles that have one (src/Theme.cpp)
+NON_INTERACTIVE = "LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE | LV_OBJ_FLAG_SCROLL_ON_FOCUS"
+
+
+# ---------- Constants ----------
+
+def read_defines(path, values=None):
+    """Integer-valued #defines of a C source, resolved in order on top of `values`."""
+    values = dict(values or {})
+    with open(path) as f:
+        for line in f:
+            m = re.match(r"\s*#define\s+(\w+)\s+(.+)", re.sub(r"//.*|/\*.*?\*/", "", line))
+            if m:
+                value = evaluate(m.group(2).strip(), values)
+                if value is not None:
+                    values[m.group(1)] = value
+    return values
+
+
+def evaluate(expr, values):
+    """Integer value of a C expression over known defines, None if it has other symbols."""
+    expr = str(expr)
+    names = re.findall(r"[A-Za-z_]\w*", expr)
+    if any(n not in values for n in names) or not re.fullmatch(r"[\w\s+\-*/()]+", expr):
+        return None
+    expr = re.sub(r"[A-Za-z_]\w*", lambda m: str(values[m.group(0)]), expr)
+    try:
+        return int(eval(expr.replace("/", "//"), {"__builtins__": {}}))  # Positive C integer maths
+    except (SyntaxError, ZeroDivisionError, TypeError):
+        return None
+
+
+def c_string(text):
+    """C literal for a label text; {NAME} becomes LV_SYMBOL_NAME."""
+    text = text.replace("\\", "\\\\").replace('"', '\\"').replace("\n", "\\n")
+    literal = '"%s"' % re.sub(r"\{(\w+)\}", r'" LV_SYMBOL_\1 "', text)
+    return re.sub(r'^"" | ""$', "", literal.replace(' "" ', " "))
+
+
+def color(value):
+    value = str(value)
+    return "lv_color_hex(%s)" % value if re.fullmatch(r"0x[0-9A-Fa-f]{6}|[A-Z_]\w*", value) else value
+
+
+# ---------- Code generation ----------
+
+class Builder:
+    def __init__(self, defines):
+        self.defines = defines
+        self.lines = []
+        self.temp = 0
+
+    def emit(self, depth, text):
+        self.lines.append("    " * depth + text)
+
+    def resolved(self, pair):
+        values = [evaluate(v, self.defines) for v in pair]
+        return None if None in values else values
+
+    def aligned_pos(self, widget, size, parent_box):
+        """(x, y) for an LV_ALIGN inside a parent of known size, like lv_obj_align."""
+        where, dx, dy = widget["align"]
+        if where not in ALIGNS:
+            raise ValueError("unknown alignment %s" % where)
+        offset = self.resolved([dx, dy])
+        if not parent_box or not offset or not (size or where == "TOP_LEFT"):
+            return None
+        pw, ph, border = parent_box
+        pw, ph = pw - 2 * border, ph - 2 * border  # Content box
+        w, h = size or (0, 0)
+        x = {"LEFT": 0, "MID": pw // 2 - w // 2, "RIGHT": pw - w}
+        y = {"TOP": 0, "MID": ph // 2 - h // 2, "BOTTOM": ph - h}
+        if where == "CENTER":
+            return x["MID"] + offset[0], y["MID"] + offset[1]
+        vert, horiz = where.split("_")
+        if vert in ("LEFT", "RIGHT"):  # LEFT_MID / RIGHT_MID
+            vert, horiz = horiz, vert
+        return x[horiz] + offset[0], y[vert] + offset[1]
+
+    def widget(self, w, parent, parent_box, depth):
+        kind = w["type"]
+        indices = w.get("index", ["i"] if not isinstance(w.get("repeat"), list) else ["row", "col"])
+        counts = w.get("repeat")
+        if counts is not None:
+            counts = counts if isinstance(counts, list) else [counts]
+            for var, count in zip(indices, counts):
+                self.emit(depth, "for (int %s = 0; %s < %s; %s++)" % (var, var, count, var))
+                self.emit(depth, "{")
+                depth += 1
+
+        name = "o%d" % self.temp
+        self.temp += 1
+        style = w.get("style")
+        if kind == "sprite":
+            create = "Theme_CreateSprite(%s, %s)" % (parent, style)
+        elif kind == "label":
+            create = "lv_label_create(%s)" % parent
+        elif kind == "bar":
+            create = "lv_bar_create(%s)" % parent
+        elif kind == "icon":
+            create = "IconAtlas_Create(%s, %s)" % (parent, w["icon"])
+        elif kind == "digits":
+            create = "DigitSprite_Create(%s, %s, %s)" % (parent, w["font"], c_string(w["text"]))
+        else:
+            raise ValueError("unknown widget type %s" % kind)
+        self.emit(depth, "lv_obj_t *%s = %s;" % (name, create))
+
+        if style and kind != "sprite":
+            self.emit(depth, "Theme_Apply(%s, %s);" % (name, style))
+        if kind == "label":
+            self.emit(depth, "lv_label_set_text(%s, %s);" % (name, c_string(w.get("text", ""))))
+        if "color" in w:
+            setter = "DigitSprite_SetColor(%s, %s);" if kind == "digits" else "lv_obj_set_style_text_color(%s, %s, 0);"
+            self.emit(depth, setter % (name, color(w["color"])))
+        if "bg_color" in w:
+            self.emit(depth, "lv_obj_set_style_bg_color(%s, %s, LV_PART_MAIN);" % (name, color(w["bg_color"])))
+        if "border_color" in w:
+            self.emit(depth, "lv_obj_set_style_border_color(%s, %s, 0);" % (name, color(w["border_color"])))
+        if "indicator_color" in w:
+            self.emit(depth, "lv_obj_set_style_bg_color(%s, %s, LV_PART_INDICATOR);" % (name, color(w["indicator_color"])))
+        if "value" in w:
+            self.emit(depth, "lv_bar_set_value(%s, %s, LV_ANIM_OFF);" % (name, w["value"]))
+
+        size = None
+        if "size" in w:
+            size = self.resolved(w["size"])
+            self.emit(depth, "lv_obj_set_size(%s, %s, %s);" % ((name,) + tuple(size or w["size"])))
+        if "pos" in w:
+            pos = self.resolved(w["pos"]) or w["pos"]
+            self.emit(depth, "lv_obj_set_pos(%s, %s, %s);" % (name, pos[0], pos[1]))
+        elif "align" in w:
+            pos = self.aligned_pos(w, size, parent_box)
+            if pos:
+                self.emit(depth, "lv_obj_set_pos(%s, %d, %d); // %s %s %s" % ((name,) + tuple(pos) + tuple(w["align"])))
+            else:
+                where, dx, dy = w["align"]
+                self.emit(depth, "lv_obj_align(%s, LV_ALIGN_%s, %s, %s);" % (name, where, dx, dy))
+        elif "align_to" in w:
+            target, where, dx, dy = w["align_to"]
+            self.emit(depth, "lv_obj_align_to(%s, %s, LV_ALIGN_%s, %s, %s);" % (name, target, where, dx, dy))
+
+        # Sprites never take input, and flags change in one call each
+        if kind == "sprite":
+            self.emit(depth, "lv_obj_clear_flag(%s, %s);" % (name, NON_INTERACTIVE))
+        if w.get("hidden"):
+            self.emit(depth, "lv_obj_add_flag(%s, LV_OBJ_FLAG_HIDDEN);" % name)
+
+        box = None
+        if size and kind == "sprite":
+            box = (size[0], size[1], FRAME_BORDER.get(style, 0))
+        for child in w.get("children", []):
+            self.widget(child, name, box, depth)
+        if "ref" in w:
+            self.emit(depth, "%s = %s;" % (w["ref"], name))
+
+        if counts is not None:
+            for _ in counts:
+                depth -= 1
+                self.emit(depth, "}")
+
+
+def generate(path, project_dir, width, height):
+    """Return (header name, header text) for one screen file."""
+    with open(path) as f:
+        spec = json.load(f)
+    name = spec["name"]
+    defines = read_defines(os.path.join(project_dir, spec["source"]),
+                           {"DISPLAY_WIDTH": width, "DISPLAY_HEIGHT": height})
+    b = Builder(defines)
+    screen = spec["screen"]
+    b.emit(1, "lv_obj_t *scr = lv_obj_create(NULL);")
+    b.emit(1, "lv_obj_set_style_bg_color(scr, %s, 0);" % color(screen.get("bg", "0x000000")))
+    b.emit(1, "lv_obj_clear_flag(scr, LV_OBJ_FLAG_SCROLLABLE);")
+    for w in spec["widgets"]:
+        b.widget(w, "scr", (width, height, 0), 1)
+    b.emit(1, "%s = scr;" % screen["ref"])
+
+    guard = "SCREEN_%s_H" % name.upper()
+    text = "\n".join([
+        "#ifndef " + guard,
+        "#define " + guard,
+        "// Generated by tools/screen_gen.py from %s - do not edit" % os.path.relpath(path, project_dir),
+        "// Include from %s only, after its object pointers" % spec["source"],
+        "#include <lvgl.h>",
+        "#include \"Theme.h\"",
+        "",
+        "static void screen_build_%s()" % name,
+        "{",
+    ] + b.lines + [
+        "}",
+        "",
+        "#endif // " + guard,
+        "",
+    ])
+    return "screen_%s.h" % name, text
+
+
+def build(screens_dir, project_dir, width, height):
+    """[(header name, text)] for every screens/*.json."""
+    if not os.path.isdir(screens_dir):
+        return []
+    return [generate(os.path.join(screens_dir, f), project_dir, width, height)
+            for f in sorted(os.listdir(screens_dir)) if f.endswith(".json")]